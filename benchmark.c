@@ -0,0 +1,852 @@
+/*
+ * benchmark.c
+ * Version 20261018
+ * Written by Harry Wong (RedAndBlueEraser)
+ *
+ * Times every function in linkedlist.h on lists of 100 to 10000000 items,
+ * allocating nodes with malloc and from a pool, and accessing positions
+ * sequentially, randomly and near the ends. Prints the results as JSON: time,
+ * allocations and cache misses (where perf_event_open is allowed) per call,
+ * and resident memory afterwards.
+ *
+ * Usage: benchmark [maximum size] [function name]
+ */
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "linkedlist.h"
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#endif
+
+/* Least time spent timing each function before moving on. */
+#define BENCHMARK_TIME 0.1
+/* Number of items removed by the remove array and list functions. */
+#define BENCHMARK_KEYS 8
+/* Number of items in the views of view functions. */
+#define BENCHMARK_PAGE 100
+
+enum {
+    BENCHMARK_SEQUENTIAL,
+    BENCHMARK_RANDOM,
+    BENCHMARK_ENDS,
+    BENCHMARK_PATTERNS
+};
+
+static const char *benchmark_patterns[] = { "sequential", "random", "ends" };
+
+typedef struct benchmark_t {
+    linkedlist_t list;
+    linkedlist_t other;
+    linkedlist_pool_t pool;
+    linkedlist_cursor_t cursor;
+    linkedlist_view_t view;
+    FILE *file;
+    void **items;
+    void **shuffled;
+    void **array;
+    void *keys[BENCHMARK_KEYS + 1];
+    size_t size;
+    int pooled;
+    int pattern;
+    size_t counter;
+    uint64_t seed;
+} benchmark_t;
+
+typedef struct benchmark_op_t {
+    const char *name;
+    int positional;
+    int resizes;
+    int whole;
+    void (*prepare)(benchmark_t *benchmark);
+    void (*run)(benchmark_t *benchmark);
+} benchmark_op_t;
+
+
+/*
+ * Count allocations by wrapping the glibc allocator.
+ */
+
+static size_t benchmark_allocs;
+
+#ifdef __GLIBC__
+#define BENCHMARK_ALLOCS
+extern void *__libc_malloc(size_t size);
+extern void *__libc_calloc(size_t count, size_t size);
+extern void *__libc_realloc(void *ptr, size_t size);
+extern void *__libc_memalign(size_t alignment, size_t size);
+
+void *malloc(size_t size) {
+    benchmark_allocs++;
+    return __libc_malloc(size);
+}
+
+void *calloc(size_t count, size_t size) {
+    benchmark_allocs++;
+    return __libc_calloc(count, size);
+}
+
+void *realloc(void *ptr, size_t size) {
+    benchmark_allocs++;
+    return __libc_realloc(ptr, size);
+}
+
+void *aligned_alloc(size_t alignment, size_t size) {
+    benchmark_allocs++;
+    return __libc_memalign(alignment, size);
+}
+#endif
+
+
+/*
+ * Count cache misses with perf_event_open where the kernel allows it.
+ */
+
+static int benchmark_perf_open(void) {
+#ifdef __linux__
+    struct perf_event_attr attr;
+
+    memset(&attr, 0, sizeof attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.size = sizeof attr;
+    attr.config = PERF_COUNT_HW_CACHE_MISSES;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    return (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+#else
+    return -1;
+#endif
+}
+
+static void benchmark_perf_start(int fd) {
+#ifdef __linux__
+    if (fd >= 0) {
+        ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+#endif
+}
+
+static uint64_t benchmark_perf_stop(int fd) {
+    uint64_t count = 0;
+#ifdef __linux__
+    if (fd >= 0) {
+        ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+        if (read(fd, &count, sizeof count) != sizeof count) {
+            count = 0;
+        }
+    }
+#endif
+    return count;
+}
+
+static size_t benchmark_rss(void) {
+    FILE *file = fopen("/proc/self/statm", "r");
+    unsigned long pages = 0, resident = 0;
+
+    if (!file) {
+        return 0;
+    }
+    if (fscanf(file, "%lu %lu", &pages, &resident) != 2) {
+        resident = 0;
+    }
+    fclose(file);
+    return resident * (size_t)sysconf(_SC_PAGESIZE);
+}
+
+
+/*
+ * Helpers to set lists up and pick positions.
+ */
+
+static uint64_t benchmark_random(benchmark_t *benchmark) {
+    /* xorshift64. */
+    benchmark->seed ^= benchmark->seed << 13;
+    benchmark->seed ^= benchmark->seed >> 7;
+    benchmark->seed ^= benchmark->seed << 17;
+    return benchmark->seed;
+}
+
+static size_t benchmark_index(benchmark_t *benchmark, size_t size) {
+    uint64_t r;
+    size_t offset;
+
+    if (size == 0) {
+        return 0;
+    }
+    switch (benchmark->pattern) {
+    case BENCHMARK_RANDOM:
+        return benchmark_random(benchmark) % size;
+    case BENCHMARK_ENDS:
+        /* Within 16 positions of either end. */
+        r = benchmark_random(benchmark);
+        offset = (r >> 1) % (size < 16 ? size : 16);
+        return r & 1 ? size - 1 - offset : offset;
+    default:
+        return benchmark->counter++ % size;
+    }
+}
+
+static void benchmark_create(benchmark_t *benchmark, linkedlist_t *list) {
+    if (benchmark->pooled) {
+        linkedlist_createpooled(list, NULL);
+    } else {
+        linkedlist_create(list);
+    }
+
+    /* Time the lists as a single thread would use them, caching. */
+    linkedlist_cache(list, 1);
+}
+
+static void benchmark_fill(benchmark_t *benchmark, void **items) {
+    /* Fill the list with every item, and empty the other list. */
+    linkedlist_destroy(&benchmark->list);
+    benchmark_create(benchmark, &benchmark->list);
+    linkedlist_addarray(&benchmark->list, items);
+    linkedlist_destroy(&benchmark->other);
+    benchmark_create(benchmark, &benchmark->other);
+    linkedlist_cursor_begin(&benchmark->list, &benchmark->cursor);
+}
+
+static void benchmark_restore(benchmark_t *benchmark) {
+    /* Bring the list back to its size, and empty the other list. */
+    while (linkedlist_size(&benchmark->list) > benchmark->size) {
+        linkedlist_pop(&benchmark->list);
+    }
+    while (linkedlist_size(&benchmark->list) < benchmark->size) {
+        linkedlist_push(&benchmark->list,
+            benchmark->items[linkedlist_size(&benchmark->list)]);
+    }
+    linkedlist_destroy(&benchmark->other);
+    benchmark_create(benchmark, &benchmark->other);
+    linkedlist_cursor_begin(&benchmark->list, &benchmark->cursor);
+}
+
+static void *benchmark_target;
+static size_t benchmark_sum;
+
+static int benchmark_test(void *data) {
+    return data == benchmark_target;
+}
+
+static void benchmark_add(void *data) {
+    benchmark_sum += (uintptr_t)data;
+}
+
+static int benchmark_compare(const void *a, const void *b) {
+    uintptr_t x = (uintptr_t)*(void *const *)a;
+    uintptr_t y = (uintptr_t)*(void *const *)b;
+    return x < y ? -1 : x > y;
+}
+
+
+/*
+ * Functions to time.
+ */
+
+static void benchmark_pool_create(benchmark_t *benchmark) {
+    linkedlist_pool_create(&benchmark->pool, 0);
+}
+
+static void benchmark_pool_destroy_prepare(benchmark_t *benchmark) {
+    /* Fill the pool's free list with nodes. */
+    linkedlist_pool_create(&benchmark->pool, 0);
+    linkedlist_destroy(&benchmark->other);
+    linkedlist_createpooled(&benchmark->other, &benchmark->pool);
+    linkedlist_addarray(&benchmark->other, benchmark->items);
+    linkedlist_destroy(&benchmark->other);
+}
+
+static void benchmark_pool_destroy(benchmark_t *benchmark) {
+    linkedlist_pool_destroy(&benchmark->pool);
+}
+
+static void benchmark_create_run(benchmark_t *benchmark) {
+    linkedlist_create(&benchmark->other);
+}
+
+static void benchmark_createpooled(benchmark_t *benchmark) {
+    linkedlist_createpooled(&benchmark->other, NULL);
+}
+
+static void benchmark_destroy_prepare(benchmark_t *benchmark) {
+    benchmark_restore(benchmark);
+}
+
+static void benchmark_destroy(benchmark_t *benchmark) {
+    linkedlist_destroy(&benchmark->list);
+}
+
+static void benchmark_clone(benchmark_t *benchmark) {
+    linkedlist_clone(&benchmark->list, &benchmark->other);
+}
+
+static void benchmark_size(benchmark_t *benchmark) {
+    benchmark_sum += linkedlist_size(&benchmark->list);
+}
+
+static void benchmark_isempty(benchmark_t *benchmark) {
+    benchmark_sum += linkedlist_isempty(&benchmark->list);
+}
+
+static void benchmark_push(benchmark_t *benchmark) {
+    linkedlist_push(&benchmark->list, benchmark->items[0]);
+}
+
+static void benchmark_pop(benchmark_t *benchmark) {
+    linkedlist_pop(&benchmark->list);
+}
+
+static void benchmark_unshift(benchmark_t *benchmark) {
+    linkedlist_unshift(&benchmark->list, benchmark->items[0]);
+}
+
+static void benchmark_shift(benchmark_t *benchmark) {
+    linkedlist_shift(&benchmark->list);
+}
+
+static void benchmark_pushn(benchmark_t *benchmark) {
+    linkedlist_pushn(&benchmark->list, benchmark->keys, BENCHMARK_KEYS);
+}
+
+static void benchmark_popn(benchmark_t *benchmark) {
+    linkedlist_popn(&benchmark->list, benchmark->array, BENCHMARK_KEYS);
+}
+
+static void benchmark_shiftn(benchmark_t *benchmark) {
+    linkedlist_shiftn(&benchmark->list, benchmark->array, BENCHMARK_KEYS);
+}
+
+static void benchmark_addrun(benchmark_t *benchmark) {
+    linkedlist_add(&benchmark->list, benchmark_index(benchmark,
+        linkedlist_size(&benchmark->list) + 1), benchmark->items[0]);
+}
+
+static void benchmark_remove(benchmark_t *benchmark) {
+    linkedlist_remove(&benchmark->list, benchmark_index(benchmark,
+        linkedlist_size(&benchmark->list)));
+}
+
+static void benchmark_set(benchmark_t *benchmark) {
+    linkedlist_set(&benchmark->list, benchmark_index(benchmark,
+        benchmark->size), benchmark->items[0]);
+}
+
+static void benchmark_addarray(benchmark_t *benchmark) {
+    linkedlist_addarray(&benchmark->other, benchmark->items);
+}
+
+static void benchmark_removearray(benchmark_t *benchmark) {
+    linkedlist_removearray(&benchmark->list, benchmark->keys);
+}
+
+static void benchmark_removearrayall(benchmark_t *benchmark) {
+    linkedlist_removearrayall(&benchmark->list, benchmark->keys);
+}
+
+static void benchmark_addlinkedlist(benchmark_t *benchmark) {
+    linkedlist_addlinkedlist(&benchmark->other, &benchmark->list);
+}
+
+static void benchmark_keys_prepare(benchmark_t *benchmark) {
+    /* Put the items to remove in the other list. */
+    benchmark_restore(benchmark);
+    linkedlist_addarray(&benchmark->other, benchmark->keys);
+}
+
+static void benchmark_removelinkedlist(benchmark_t *benchmark) {
+    linkedlist_removelinkedlist(&benchmark->list, &benchmark->other);
+}
+
+static void benchmark_removelinkedlistall(benchmark_t *benchmark) {
+    linkedlist_removelinkedlistall(&benchmark->list, &benchmark->other);
+}
+
+static void benchmark_halve_prepare(benchmark_t *benchmark) {
+    /* Move the second half of the list to the other list. */
+    benchmark_restore(benchmark);
+    linkedlist_split(&benchmark->list, benchmark->size / 2,
+        &benchmark->other);
+}
+
+static void benchmark_concat(benchmark_t *benchmark) {
+    linkedlist_concat(&benchmark->list, &benchmark->other);
+}
+
+static void benchmark_splice(benchmark_t *benchmark) {
+    linkedlist_splice(&benchmark->list, benchmark_index(benchmark,
+        linkedlist_size(&benchmark->list) + 1), &benchmark->other);
+}
+
+static void benchmark_split(benchmark_t *benchmark) {
+    linkedlist_split(&benchmark->list, benchmark->size / 2,
+        &benchmark->other);
+}
+
+static void benchmark_get(benchmark_t *benchmark) {
+    benchmark_target = linkedlist_get(&benchmark->list,
+        benchmark_index(benchmark, benchmark->size));
+}
+
+static void benchmark_first(benchmark_t *benchmark) {
+    benchmark_target = linkedlist_first(&benchmark->list);
+}
+
+static void benchmark_last(benchmark_t *benchmark) {
+    benchmark_target = linkedlist_last(&benchmark->list);
+}
+
+static void benchmark_indexof(benchmark_t *benchmark) {
+    benchmark_sum += linkedlist_indexof(&benchmark->list,
+        benchmark->items[benchmark_index(benchmark, benchmark->size)]);
+}
+
+static void benchmark_indexofany(benchmark_t *benchmark) {
+    void *keys[5];
+
+    /* Search for an item in the list and three which are not. */
+    keys[0] = (void *)(uintptr_t)(benchmark->size + 1);
+    keys[1] = (void *)(uintptr_t)(benchmark->size + 2);
+    keys[2] = (void *)(uintptr_t)(benchmark->size + 3);
+    keys[3] = benchmark->items[benchmark_index(benchmark, benchmark->size)];
+    keys[4] = NULL;
+    benchmark_sum += linkedlist_indexofany(&benchmark->list, keys);
+}
+
+static void benchmark_find(benchmark_t *benchmark) {
+    benchmark_target = benchmark->items[benchmark_index(benchmark,
+        benchmark->size)];
+    linkedlist_find(&benchmark->list, benchmark_test);
+}
+
+static void benchmark_findindex(benchmark_t *benchmark) {
+    benchmark_target = benchmark->items[benchmark_index(benchmark,
+        benchmark->size)];
+    benchmark_sum += linkedlist_findindex(&benchmark->list, benchmark_test);
+}
+
+static void benchmark_foreach(benchmark_t *benchmark) {
+    linkedlist_foreach(&benchmark->list, benchmark_add);
+}
+
+static void benchmark_foreachreverse(benchmark_t *benchmark) {
+    linkedlist_foreachreverse(&benchmark->list, benchmark_add);
+}
+
+static void benchmark_cursor_prepare(benchmark_t *benchmark) {
+    linkedlist_cursor_begin(&benchmark->list, &benchmark->cursor);
+}
+
+static void benchmark_cursor_begin(benchmark_t *benchmark) {
+    linkedlist_cursor_begin(&benchmark->list, &benchmark->cursor);
+}
+
+static void benchmark_cursor_beginreverse(benchmark_t *benchmark) {
+    linkedlist_cursor_beginreverse(&benchmark->list, &benchmark->cursor);
+}
+
+static void benchmark_cursor_isend(benchmark_t *benchmark) {
+    benchmark_sum += linkedlist_cursor_isend(&benchmark->cursor);
+}
+
+static void benchmark_cursor_next(benchmark_t *benchmark) {
+    if (linkedlist_cursor_isend(&benchmark->cursor)) {
+        linkedlist_cursor_begin(&benchmark->list, &benchmark->cursor);
+    }
+    linkedlist_cursor_next(&benchmark->cursor);
+}
+
+static void benchmark_cursor_prev(benchmark_t *benchmark) {
+    if (linkedlist_cursor_isend(&benchmark->cursor)) {
+        linkedlist_cursor_beginreverse(&benchmark->list, &benchmark->cursor);
+    }
+    linkedlist_cursor_prev(&benchmark->cursor);
+}
+
+static void benchmark_cursor_index(benchmark_t *benchmark) {
+    benchmark_sum += linkedlist_cursor_index(&benchmark->cursor);
+}
+
+static void benchmark_cursor_get(benchmark_t *benchmark) {
+    benchmark_target = linkedlist_cursor_get(&benchmark->cursor);
+}
+
+static void benchmark_cursor_set(benchmark_t *benchmark) {
+    linkedlist_cursor_set(&benchmark->cursor, benchmark->items[0]);
+}
+
+static void benchmark_cursor_insertafter(benchmark_t *benchmark) {
+    linkedlist_cursor_insertafter(&benchmark->cursor, benchmark->items[0]);
+}
+
+static void benchmark_cursor_remove(benchmark_t *benchmark) {
+    if (linkedlist_cursor_isend(&benchmark->cursor)) {
+        linkedlist_cursor_begin(&benchmark->list, &benchmark->cursor);
+    }
+    linkedlist_cursor_remove(&benchmark->cursor);
+}
+
+static void benchmark_view_create(benchmark_t *benchmark) {
+    size_t start = benchmark_index(benchmark, benchmark->size);
+    linkedlist_view_create(&benchmark->list, start, start + BENCHMARK_PAGE,
+        &benchmark->view);
+}
+
+static void benchmark_view_fromcursor(benchmark_t *benchmark) {
+    linkedlist_view_fromcursor(&benchmark->cursor, BENCHMARK_PAGE,
+        &benchmark->view);
+}
+
+static void benchmark_view_prepare(benchmark_t *benchmark) {
+    /* View a page from the middle of the list. */
+    linkedlist_view_create(&benchmark->list, benchmark->size / 2,
+        benchmark->size / 2 + BENCHMARK_PAGE, &benchmark->view);
+    benchmark_target = linkedlist_get(&benchmark->list,
+        benchmark->size / 2 + linkedlist_view_size(&benchmark->view) - 1);
+}
+
+static void benchmark_view_size(benchmark_t *benchmark) {
+    benchmark_sum += linkedlist_view_size(&benchmark->view);
+}
+
+static void benchmark_view_indexof(benchmark_t *benchmark) {
+    benchmark_sum += linkedlist_view_indexof(&benchmark->view,
+        benchmark_target);
+}
+
+static void benchmark_view_find(benchmark_t *benchmark) {
+    benchmark_sum += (uintptr_t)linkedlist_view_find(&benchmark->view,
+        benchmark_test);
+}
+
+static void benchmark_view_foreach(benchmark_t *benchmark) {
+    linkedlist_view_foreach(&benchmark->view, benchmark_add);
+}
+
+static void benchmark_view_toarray(benchmark_t *benchmark) {
+    linkedlist_view_toarray(&benchmark->view, benchmark->array);
+}
+
+static void benchmark_slice(benchmark_t *benchmark) {
+    linkedlist_slice(&benchmark->list, benchmark->size / 4,
+        benchmark->size - benchmark->size / 4);
+}
+
+static void benchmark_rotate(benchmark_t *benchmark) {
+    linkedlist_rotate(&benchmark->list, benchmark->size / 3);
+}
+
+static void benchmark_toarray(benchmark_t *benchmark) {
+    linkedlist_toarray(&benchmark->list, benchmark->array);
+}
+
+static void benchmark_save(benchmark_t *benchmark) {
+    rewind(benchmark->file);
+    linkedlist_save(&benchmark->list, benchmark->file, NULL);
+    fflush(benchmark->file);
+}
+
+static void benchmark_load_prepare(benchmark_t *benchmark) {
+    benchmark_save(benchmark);
+    linkedlist_destroy(&benchmark->other);
+    rewind(benchmark->file);
+}
+
+static void benchmark_load(benchmark_t *benchmark) {
+    linkedlist_load(&benchmark->other, NULL, benchmark->file, NULL);
+}
+
+static void benchmark_reverse(benchmark_t *benchmark) {
+    linkedlist_reverse(&benchmark->list);
+}
+
+static void benchmark_sort_prepare(benchmark_t *benchmark) {
+    linkedlist_destroy(&benchmark->list);
+    linkedlist_addarray(&benchmark->list, benchmark->shuffled);
+}
+
+static void benchmark_sort(benchmark_t *benchmark) {
+    linkedlist_sort(&benchmark->list, benchmark_compare);
+}
+
+static uint64_t benchmark_key(void *data) {
+    return (uintptr_t)data;
+}
+
+static void benchmark_sortkey(benchmark_t *benchmark) {
+    linkedlist_sortkey(&benchmark->list, benchmark_key);
+}
+
+static void benchmark_compact_prepare(benchmark_t *benchmark) {
+    /* Scatter the nodes by sorting a shuffled list. */
+    benchmark_fill(benchmark, benchmark->shuffled);
+    linkedlist_sort(&benchmark->list, benchmark_compare);
+}
+
+static void benchmark_compact(benchmark_t *benchmark) {
+    linkedlist_compact(&benchmark->list);
+}
+
+static void benchmark_invalidate(benchmark_t *benchmark) {
+    linkedlist_invalidate(&benchmark->list);
+}
+
+static void benchmark_cache(benchmark_t *benchmark) {
+    linkedlist_cache(&benchmark->list, 1);
+}
+
+/* Name, positional, resizes, whole, prepare, run. Positional functions are
+ * timed with each access pattern. Functions which resize the list (by the
+ * number of items given) are timed until they would have added or removed at
+ * most half the list size before the list is restored. Whole list
+ * functions are prepared before every call instead of every batch of calls.
+ */
+static const benchmark_op_t benchmark_ops[] = {
+    { "linkedlist_pool_create", 0, 0, 0, NULL, benchmark_pool_create },
+    { "linkedlist_pool_destroy", 0, 0, 1, benchmark_pool_destroy_prepare,
+        benchmark_pool_destroy },
+    { "linkedlist_create", 0, 0, 0, NULL, benchmark_create_run },
+    { "linkedlist_createpooled", 0, 0, 0, NULL, benchmark_createpooled },
+    { "linkedlist_destroy", 0, 0, 1, benchmark_destroy_prepare,
+        benchmark_destroy },
+    { "linkedlist_clone", 0, 0, 1, benchmark_restore, benchmark_clone },
+    { "linkedlist_size", 0, 0, 0, NULL, benchmark_size },
+    { "linkedlist_isempty", 0, 0, 0, NULL, benchmark_isempty },
+    { "linkedlist_push", 0, 1, 0, NULL, benchmark_push },
+    { "linkedlist_pop", 0, 1, 0, NULL, benchmark_pop },
+    { "linkedlist_unshift", 0, 1, 0, NULL, benchmark_unshift },
+    { "linkedlist_shift", 0, 1, 0, NULL, benchmark_shift },
+    { "linkedlist_pushn", 0, BENCHMARK_KEYS, 0, NULL, benchmark_pushn },
+    { "linkedlist_popn", 0, BENCHMARK_KEYS, 0, NULL, benchmark_popn },
+    { "linkedlist_shiftn", 0, BENCHMARK_KEYS, 0, NULL, benchmark_shiftn },
+    { "linkedlist_add", 1, 1, 0, NULL, benchmark_addrun },
+    { "linkedlist_remove", 1, 1, 0, NULL, benchmark_remove },
+    { "linkedlist_set", 1, 0, 0, NULL, benchmark_set },
+    { "linkedlist_addarray", 0, 0, 1, benchmark_restore, benchmark_addarray },
+    { "linkedlist_removearray", 0, 0, 1, benchmark_restore,
+        benchmark_removearray },
+    { "linkedlist_removearrayall", 0, 0, 1, benchmark_restore,
+        benchmark_removearrayall },
+    { "linkedlist_addlinkedlist", 0, 0, 1, benchmark_restore,
+        benchmark_addlinkedlist },
+    { "linkedlist_removelinkedlist", 0, 0, 1, benchmark_keys_prepare,
+        benchmark_removelinkedlist },
+    { "linkedlist_removelinkedlistall", 0, 0, 1, benchmark_keys_prepare,
+        benchmark_removelinkedlistall },
+    { "linkedlist_concat", 0, 0, 1, benchmark_halve_prepare,
+        benchmark_concat },
+    { "linkedlist_splice", 1, 0, 1, benchmark_halve_prepare,
+        benchmark_splice },
+    { "linkedlist_get", 1, 0, 0, NULL, benchmark_get },
+    { "linkedlist_first", 0, 0, 0, NULL, benchmark_first },
+    { "linkedlist_last", 0, 0, 0, NULL, benchmark_last },
+    { "linkedlist_indexof", 1, 0, 0, NULL, benchmark_indexof },
+    { "linkedlist_indexofany", 1, 0, 0, NULL, benchmark_indexofany },
+    { "linkedlist_find", 1, 0, 0, NULL, benchmark_find },
+    { "linkedlist_findindex", 1, 0, 0, NULL, benchmark_findindex },
+    { "linkedlist_foreach", 0, 0, 0, NULL, benchmark_foreach },
+    { "linkedlist_foreachreverse", 0, 0, 0, NULL, benchmark_foreachreverse },
+    { "linkedlist_cursor_begin", 0, 0, 0, NULL, benchmark_cursor_begin },
+    { "linkedlist_cursor_beginreverse", 0, 0, 0, NULL,
+        benchmark_cursor_beginreverse },
+    { "linkedlist_cursor_isend", 0, 0, 0, benchmark_cursor_prepare,
+        benchmark_cursor_isend },
+    { "linkedlist_cursor_next", 0, 0, 0, benchmark_cursor_prepare,
+        benchmark_cursor_next },
+    { "linkedlist_cursor_prev", 0, 0, 0, benchmark_cursor_prepare,
+        benchmark_cursor_prev },
+    { "linkedlist_cursor_index", 0, 0, 0, benchmark_cursor_prepare,
+        benchmark_cursor_index },
+    { "linkedlist_cursor_get", 0, 0, 0, benchmark_cursor_prepare,
+        benchmark_cursor_get },
+    { "linkedlist_cursor_set", 0, 0, 0, benchmark_cursor_prepare,
+        benchmark_cursor_set },
+    { "linkedlist_cursor_insertafter", 0, 1, 0, benchmark_cursor_prepare,
+        benchmark_cursor_insertafter },
+    { "linkedlist_cursor_remove", 0, 1, 0, benchmark_cursor_prepare,
+        benchmark_cursor_remove },
+    { "linkedlist_view_create", 1, 0, 0, NULL, benchmark_view_create },
+    { "linkedlist_view_fromcursor", 0, 0, 0, benchmark_cursor_prepare,
+        benchmark_view_fromcursor },
+    { "linkedlist_view_size", 0, 0, 0, benchmark_view_prepare,
+        benchmark_view_size },
+    { "linkedlist_view_indexof", 0, 0, 0, benchmark_view_prepare,
+        benchmark_view_indexof },
+    { "linkedlist_view_find", 0, 0, 0, benchmark_view_prepare,
+        benchmark_view_find },
+    { "linkedlist_view_foreach", 0, 0, 0, benchmark_view_prepare,
+        benchmark_view_foreach },
+    { "linkedlist_view_toarray", 0, 0, 0, benchmark_view_prepare,
+        benchmark_view_toarray },
+    { "linkedlist_slice", 0, 0, 1, benchmark_restore, benchmark_slice },
+    { "linkedlist_split", 0, 0, 1, benchmark_restore, benchmark_split },
+    { "linkedlist_rotate", 0, 0, 0, NULL, benchmark_rotate },
+    { "linkedlist_toarray", 0, 0, 0, NULL, benchmark_toarray },
+    { "linkedlist_save", 0, 0, 0, NULL, benchmark_save },
+    { "linkedlist_load", 0, 0, 1, benchmark_load_prepare, benchmark_load },
+    { "linkedlist_reverse", 0, 0, 0, NULL, benchmark_reverse },
+    { "linkedlist_sort", 0, 0, 1, benchmark_sort_prepare, benchmark_sort },
+    { "linkedlist_sortkey", 0, 0, 1, benchmark_sort_prepare,
+        benchmark_sortkey },
+    { "linkedlist_compact", 0, 0, 1, benchmark_compact_prepare,
+        benchmark_compact },
+    { "linkedlist_invalidate", 0, 0, 0, NULL, benchmark_invalidate },
+    { "linkedlist_cache", 0, 0, 0, NULL, benchmark_cache }
+};
+
+
+/*
+ * Timing.
+ */
+
+static double benchmark_now(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec * 1e-9;
+}
+
+static void benchmark_measure(benchmark_t *benchmark,
+    const benchmark_op_t *op, int perf, int *first) {
+    size_t calls = 0, allocs = 0, batch = 1, limit, i;
+    uint64_t misses = 0;
+    double elapsed = 0, start;
+
+    /* Functions which resize the list may only run so long before it is
+     * restored.
+     */
+    limit = op->resizes ? benchmark->size / 2 / op->resizes : SIZE_MAX;
+    if (limit == 0) {
+        limit = 1;
+    }
+    benchmark->counter = 0;
+    benchmark->seed = 88172645463325252ULL;
+    benchmark_fill(benchmark, benchmark->items);
+
+    /* Time batches of calls, doubling in size, until enough time is spent. */
+    while (elapsed < BENCHMARK_TIME) {
+        if (op->resizes) {
+            benchmark_restore(benchmark);
+        }
+        if (op->prepare) {
+            op->prepare(benchmark);
+        }
+
+        benchmark_allocs = 0;
+        benchmark_perf_start(perf);
+        start = benchmark_now();
+        for (i = 0; i < batch; i++) {
+            op->run(benchmark);
+        }
+        elapsed += benchmark_now() - start;
+        misses += benchmark_perf_stop(perf);
+        allocs += benchmark_allocs;
+        calls += batch;
+
+        if (!op->whole) {
+            batch = batch * 2 < limit ? batch * 2 : limit;
+        }
+    }
+
+    /* Print results. */
+    printf("%s\n  {\"function\": \"%s\", \"allocator\": \"%s\", "
+        "\"size\": %zu, \"pattern\": ", *first ? "" : ",", op->name,
+        benchmark->pooled ? "pool" : "malloc", benchmark->size);
+    if (op->positional) {
+        printf("\"%s\", ", benchmark_patterns[benchmark->pattern]);
+    } else {
+        printf("null, ");
+    }
+    printf("\"calls\": %zu, \"ns_per_op\": %.2f, ", calls,
+        elapsed * 1e9 / calls);
+#ifdef BENCHMARK_ALLOCS
+    printf("\"allocs_per_op\": %.3f, ", (double)allocs / calls);
+#else
+    printf("\"allocs_per_op\": null, ");
+#endif
+    if (perf >= 0) {
+        printf("\"cache_misses_per_op\": %.2f, ", (double)misses / calls);
+    } else {
+        printf("\"cache_misses_per_op\": null, ");
+    }
+    printf("\"rss_bytes\": %zu}", benchmark_rss());
+    fflush(stdout);
+    *first = 0;
+}
+
+int main(int argc, char *argv[]) {
+    size_t maxsize = argc > 1 ? (size_t)atol(argv[1]) : 10000000, size, i, j;
+    const char *function = argc > 2 ? argv[2] : NULL;
+    benchmark_t benchmark;
+    int perf = benchmark_perf_open(), first = 1;
+    const benchmark_op_t *op;
+    void *swap;
+
+    linkedlist_create(&benchmark.list);
+    linkedlist_create(&benchmark.other);
+    benchmark.file = tmpfile();
+    if (!benchmark.file) {
+        fprintf(stderr, "Cannot create file\n");
+        return 1;
+    }
+    benchmark.seed = 88172645463325252ULL;
+
+    printf("[");
+    for (size = 100; size <= maxsize; size *= 10) {
+        /* Create items 1 to size, in order and shuffled. */
+        benchmark.size = size;
+        benchmark.items = (void**)malloc((size + 1) * sizeof(void *));
+        benchmark.shuffled = (void**)malloc((size + 1) * sizeof(void *));
+        benchmark.array = (void**)malloc((size + 1) * sizeof(void *));
+        if (!benchmark.items || !benchmark.shuffled || !benchmark.array) {
+            fprintf(stderr, "Out of memory\n");
+            return 1;
+        }
+        for (i = 0; i < size; i++) {
+            benchmark.items[i] = benchmark.shuffled[i] = (void *)(i + 1);
+        }
+        benchmark.items[size] = benchmark.shuffled[size] = NULL;
+        for (i = size - 1; i > 0; i--) {
+            j = benchmark_random(&benchmark) % (i + 1);
+            swap = benchmark.shuffled[i];
+            benchmark.shuffled[i] = benchmark.shuffled[j];
+            benchmark.shuffled[j] = swap;
+        }
+        for (i = 0; i < BENCHMARK_KEYS; i++) {
+            benchmark.keys[i] = benchmark.shuffled[i % size];
+        }
+        benchmark.keys[BENCHMARK_KEYS] = NULL;
+
+        /* Time each function with each allocator and access pattern. */
+        for (op = benchmark_ops; op < benchmark_ops + sizeof benchmark_ops
+            / sizeof benchmark_ops[0]; op++) {
+            if (function && strcmp(function, op->name) != 0) {
+                continue;
+            }
+            for (benchmark.pooled = 0; benchmark.pooled <= 1;
+                benchmark.pooled++) {
+                for (benchmark.pattern = 0; benchmark.pattern
+                    < (op->positional ? BENCHMARK_PATTERNS : 1);
+                    benchmark.pattern++) {
+                    benchmark_measure(&benchmark, op, perf, &first);
+                }
+            }
+        }
+
+        linkedlist_destroy(&benchmark.list);
+        linkedlist_destroy(&benchmark.other);
+        free(benchmark.items);
+        free(benchmark.shuffled);
+        free(benchmark.array);
+    }
+    printf("\n]\n");
+    return 0;
+}
@@ -0,0 +1,128 @@
+/*
+ * benchmark_queue.c
+ * Version 20261018
+ * Written by Harry Wong (RedAndBlueEraser)
+ *
+ * Measures the throughput of linkedlist_queue_t against a linkedlist_t guarded
+ * by a mutex, with 1 to N producer and consumer threads each.
+ *
+ * Usage: benchmark_queue [maximum threads] [items per producer]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <pthread.h>
+#include <time.h>
+#include "linkedlist.h"
+#include "linkedlist_queue.h"
+
+typedef struct benchmark_t {
+    int lockfree;
+    linkedlist_queue_t *queue;
+    linkedlist_t *list;
+    pthread_mutex_t *mutex;
+    size_t items;
+    atomic_size_t remaining;
+} benchmark_t;
+
+static void *benchmark_produce(void *arg) {
+    benchmark_t *benchmark = (benchmark_t*)arg;
+    size_t i;
+
+    for (i = 1; i <= benchmark->items; i++) {
+        if (benchmark->lockfree) {
+            linkedlist_queue_push(benchmark->queue, (void *)i);
+        } else {
+            pthread_mutex_lock(benchmark->mutex);
+            linkedlist_push(benchmark->list, (void *)i);
+            pthread_mutex_unlock(benchmark->mutex);
+        }
+    }
+    return NULL;
+}
+
+static void *benchmark_consume(void *arg) {
+    benchmark_t *benchmark = (benchmark_t*)arg;
+    void *data;
+
+    while (atomic_load_explicit(&benchmark->remaining,
+        memory_order_relaxed) > 0) {
+        if (benchmark->lockfree) {
+            data = linkedlist_queue_shift(benchmark->queue);
+        } else {
+            data = NULL;
+            pthread_mutex_lock(benchmark->mutex);
+            if (!linkedlist_isempty(benchmark->list)) {
+                data = linkedlist_shift(benchmark->list);
+            }
+            pthread_mutex_unlock(benchmark->mutex);
+        }
+        if (data) {
+            atomic_fetch_sub_explicit(&benchmark->remaining, 1,
+                memory_order_relaxed);
+        }
+    }
+    return NULL;
+}
+
+static double benchmark_run(int lockfree, int producers, int consumers,
+    size_t items) {
+    pthread_t threads[2 * LINKEDLIST_QUEUE_MAXTHREADS];
+    static linkedlist_queue_t queue;
+    linkedlist_t list;
+    pthread_mutex_t mutex = PTHREAD_MUTEX_INITIALIZER;
+    benchmark_t benchmark;
+    struct timespec start, end;
+    int i;
+
+    linkedlist_queue_create(&queue);
+    linkedlist_create(&list);
+    benchmark.lockfree = lockfree;
+    benchmark.queue = &queue;
+    benchmark.list = &list;
+    benchmark.mutex = &mutex;
+    benchmark.items = items;
+    atomic_init(&benchmark.remaining, items * producers);
+
+    /* Time producers and consumers until every item is consumed. */
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (i = 0; i < producers; i++) {
+        pthread_create(&threads[i], NULL, benchmark_produce, &benchmark);
+    }
+    for (i = 0; i < consumers; i++) {
+        pthread_create(&threads[producers + i], NULL, benchmark_consume,
+            &benchmark);
+    }
+    for (i = 0; i < producers + consumers; i++) {
+        pthread_join(threads[i], NULL);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    linkedlist_queue_destroy(&queue);
+    linkedlist_destroy(&list);
+    return items * producers / ((end.tv_sec - start.tv_sec)
+        + (end.tv_nsec - start.tv_nsec) * 1e-9) / 1e6;
+}
+
+int main(int argc, char *argv[]) {
+    int maxthreads = argc > 1 ? atoi(argv[1]) : 8, producers, consumers;
+    size_t items = argc > 2 ? (size_t)atol(argv[2]) : 1000000;
+
+    if (maxthreads < 1 || maxthreads > LINKEDLIST_QUEUE_MAXTHREADS / 2) {
+        fprintf(stderr, "Maximum threads must be from 1 to %d\n",
+            LINKEDLIST_QUEUE_MAXTHREADS / 2);
+        return 1;
+    }
+
+    printf("producers consumers lockfree_mops mutex_mops\n");
+    for (producers = 1; producers <= maxthreads; producers *= 2) {
+        for (consumers = 1; consumers <= maxthreads; consumers *= 2) {
+            printf("%9d %9d %13.2f %10.2f\n", producers, consumers,
+                benchmark_run(1, producers, consumers, items),
+                benchmark_run(0, producers, consumers, items));
+            fflush(stdout);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,1145 @@
+/*
+ * check.c
+ * Version 20261018
+ * Written by Harry Wong (RedAndBlueEraser)
+ *
+ * Checks the list modules built alongside linkedlist.c, by running each
+ * module's functions and comparing the results with the results they should
+ * have. Prints each module checked, and the first check to fail in it.
+ *
+ * Usage: check
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include "linkedlist.h"
+#include "linkedlist_intrusive.h"
+#include "linkedlist_packed.h"
+#include "linkedlist_parallel.h"
+#include "linkedlist_persistent.h"
+#include "linkedlist_query.h"
+#include "linkedlist_queue.h"
+#include "linkedlist_rcu.h"
+#include "linkedlist_sharded.h"
+#include "linkedlist_skip.h"
+#include "linkedlist_typed.h"
+#include "linkedlist_unrolled.h"
+
+/* Fail the current module's check with the condition which does not hold. */
+#define CHECK(condition)                                                      \
+    do {                                                                      \
+        if (!(condition)) {                                                   \
+            fprintf(stderr, "check.c:%d: %s\n", __LINE__, #condition);        \
+            return 1;                                                         \
+        }                                                                     \
+    } while (0)
+
+/* Number of items in the lists checked, and of random changes made to lists
+ * checked against a linkedlist_t.
+ */
+#define CHECK_ITEMS 1000
+#define CHECK_CHANGES 4000
+
+/* Number of threads which read or change a list at once. */
+#define CHECK_THREADS 4
+
+static void *check_expected[4 * CHECK_CHANGES + 1];
+static void *check_actual[4 * CHECK_CHANGES + 1];
+
+typedef struct check_entry_t {
+    uintptr_t value;
+    linkedlist_link_t link;
+} check_entry_t;
+
+static check_entry_t check_entries[CHECK_CHANGES + 1];
+
+static linkedlist_t check_list;
+static linkedlist_queue_t check_queuelist;
+static atomic_size_t check_shifted;
+static linkedlist_rcu_t check_rculist;
+static linkedlist_sharded_t check_shardedlist;
+
+/* Number of each thread which needs one, passed as its argument. */
+static size_t check_numbers[CHECK_THREADS];
+
+LINKEDLIST_DECLARE(intlist, int)
+LINKEDLIST_DEFINE(intlist, int)
+
+
+/*
+ * Helpers.
+ */
+
+static void *check_item(void) {
+    return (void*)(uintptr_t)(1 + rand() % CHECK_ITEMS);
+}
+
+static int check_same(linkedlist_t *model) {
+    size_t i;
+
+    /* Compare the items copied to check_actual with the model's items. */
+    linkedlist_toarray(model, check_expected);
+    for (i = 0; i <= linkedlist_size(model); i++) {
+        if (check_actual[i] != check_expected[i]) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+
+/*
+ * Tests. A test which returns a value other than 0 or 1 checks that only 1 is
+ * taken as a pass.
+ */
+
+static size_t check_count;
+
+static uintptr_t check_value(const linkedlist_link_t *link) {
+    return LINKEDLIST_CONTAINER(link, check_entry_t, link)->value;
+}
+
+static void check_append(void *data) {
+    check_actual[check_count++] = data;
+    check_actual[check_count] = NULL;
+}
+
+static void check_linkappend(linkedlist_link_t *link) {
+    check_actual[check_count++] = link;
+    check_actual[check_count] = NULL;
+}
+
+static int check_iseven(void *data) {
+    return (uintptr_t)data % 2 == 0 ? 1 : 2;
+}
+
+static int check_linkiseven(linkedlist_link_t *link) {
+    return check_value(link) % 2 == 0 ? 1 : 2;
+}
+
+static int check_entryiseven(void *data) {
+    return check_linkiseven((linkedlist_link_t*)data);
+}
+
+static int check_linkcompare(const linkedlist_link_t *a,
+    const linkedlist_link_t *b) {
+    uintptr_t x = check_value(a), y = check_value(b);
+
+    return (x > y) - (x < y);
+}
+
+static int check_entrycompare(const void *a, const void *b) {
+    return check_linkcompare(*(linkedlist_link_t *const *)a,
+        *(linkedlist_link_t *const *)b);
+}
+
+static int check_islast(void *data) {
+    return (uintptr_t)data == CHECK_ITEMS + 1 ? 1 : 2;
+}
+
+static int check_compare(const void *a, const void *b) {
+    uintptr_t x = *(const uintptr_t *)a, y = *(const uintptr_t *)b;
+
+    return (x > y) - (x < y);
+}
+
+static size_t check_total;
+static atomic_size_t check_atomictotal;
+
+static void check_add(void *data) {
+    check_total += (uintptr_t)data;
+}
+
+static void check_atomicadd(void *data) {
+    atomic_fetch_add(&check_atomictotal, (uintptr_t)data);
+}
+
+static void *check_double(void *data) {
+    return (void*)((uintptr_t)data * 2);
+}
+
+static void check_accumulate(void *acc, void *data) {
+    *(size_t*)acc += (uintptr_t)data;
+}
+
+static int check_intiseven(const int *data) {
+    return *data % 2 == 0 ? 1 : 2;
+}
+
+static int check_intcompare(const int *a, const int *b) {
+    return (*a > *b) - (*a < *b);
+}
+
+static size_t check_sum;
+
+static void check_intadd(int *data) {
+    check_sum += (size_t)*data;
+}
+
+
+/*
+ * Modules.
+ */
+
+static void *check_pusher(void *arg) {
+    size_t shard = *(size_t*)arg, i;
+
+    /* Push items numbered in order after the shard's number, and hand them
+     * over.
+     */
+    for (i = 1; i <= CHECK_CHANGES; i++) {
+        linkedlist_sharded_push(&check_shardedlist, shard,
+            (void*)(uintptr_t)(shard * CHECK_CHANGES + i));
+    }
+    linkedlist_sharded_publish(&check_shardedlist, shard);
+    return NULL;
+}
+
+static int check_sharded(void) {
+    pthread_t threads[CHECK_THREADS];
+    size_t last[CHECK_THREADS] = { 0 }, i, shard, item, count = 0;
+    linkedlist_t dest;
+    void *data;
+
+    /* Flush the items while threads push them, until every item is flushed. */
+    CHECK(linkedlist_sharded_create(&check_shardedlist, CHECK_THREADS) == 0);
+    for (i = 0; i < CHECK_THREADS; i++) {
+        check_numbers[i] = i;
+        CHECK(pthread_create(&threads[i], NULL, check_pusher,
+            &check_numbers[i]) == 0);
+    }
+    while (count < CHECK_THREADS * CHECK_CHANGES) {
+        CHECK(linkedlist_sharded_flush(&check_shardedlist, &dest, 1) == 0);
+
+        /* Each shard's items must come in the order they were pushed. */
+        while (!linkedlist_isempty(&dest)) {
+            data = linkedlist_shift(&dest);
+            shard = ((uintptr_t)data - 1) / CHECK_CHANGES;
+            item = ((uintptr_t)data - 1) % CHECK_CHANGES + 1;
+            CHECK(shard < CHECK_THREADS && item == last[shard] + 1);
+            last[shard] = item;
+            count++;
+        }
+        linkedlist_destroy(&dest);
+    }
+    for (i = 0; i < CHECK_THREADS; i++) {
+        pthread_join(threads[i], NULL);
+    }
+
+    /* Nothing is left once every item is flushed. */
+    CHECK(linkedlist_sharded_flush(&check_shardedlist, &dest, 0) == 0);
+    CHECK(linkedlist_isempty(&dest));
+    linkedlist_destroy(&dest);
+    linkedlist_sharded_destroy(&check_shardedlist);
+    return 0;
+}
+
+
+static int check_skip(void) {
+    linkedlist_skip_t list, copy;
+    linkedlist_t model;
+    void *keys[3];
+    size_t i, index;
+    void *data;
+
+    /* Make the same random changes to the list and a model. */
+    linkedlist_skip_create(&list);
+    linkedlist_create(&model);
+    for (i = 0; i < CHECK_CHANGES; i++) {
+        data = check_item();
+        index = (size_t)rand() % (linkedlist_size(&model) + 1);
+        switch (rand() % 8) {
+        case 0:
+            CHECK(linkedlist_skip_push(&list, data) == 0);
+            linkedlist_push(&model, data);
+            break;
+        case 1:
+            CHECK(linkedlist_skip_unshift(&list, data) == 0);
+            linkedlist_unshift(&model, data);
+            break;
+        case 2:
+            CHECK(linkedlist_skip_add(&list, index, data) == 0);
+            linkedlist_add(&model, index, data);
+            break;
+        case 3:
+            if (index < linkedlist_size(&model)) {
+                CHECK(linkedlist_skip_remove(&list, index)
+                    == linkedlist_remove(&model, index));
+            }
+            break;
+        case 4:
+            if (index < linkedlist_size(&model)) {
+                CHECK(linkedlist_skip_set(&list, index, data) == 0);
+                linkedlist_set(&model, index, data);
+            }
+            break;
+        case 5:
+            keys[0] = data;
+            keys[1] = check_item();
+            keys[2] = NULL;
+            CHECK(linkedlist_skip_addarray(&list, keys) == 0);
+            linkedlist_addarray(&model, keys);
+            break;
+        case 6:
+            if (!linkedlist_isempty(&model)) {
+                CHECK(linkedlist_skip_pop(&list) == linkedlist_pop(&model));
+            }
+            break;
+        default:
+            if (!linkedlist_isempty(&model)) {
+                CHECK(linkedlist_skip_shift(&list)
+                    == linkedlist_shift(&model));
+            }
+        }
+    }
+    CHECK(linkedlist_skip_size(&list) == linkedlist_size(&model));
+    CHECK(linkedlist_skip_toarray(&list, check_actual) == 0);
+    CHECK(check_same(&model));
+
+    /* Search both, starting with an item which fails the test, and get every
+     * item by position.
+     */
+    CHECK(linkedlist_skip_unshift(&list, (void*)1) == 0);
+    linkedlist_unshift(&model, (void*)1);
+    data = check_item();
+    CHECK(linkedlist_skip_indexof(&list, data)
+        == linkedlist_indexof(&model, data));
+    CHECK(linkedlist_skip_find(&list, check_iseven)
+        == linkedlist_find(&model, check_iseven));
+    CHECK(linkedlist_skip_findindex(&list, check_iseven)
+        == linkedlist_findindex(&model, check_iseven));
+    for (i = 0; i < linkedlist_size(&model); i++) {
+        CHECK(linkedlist_skip_get(&list, i) == linkedlist_get(&model, i));
+    }
+
+    /* Slice a copy of both. */
+    CHECK(linkedlist_skip_clone(&list, &copy) == 0);
+    linkedlist_skip_destroy(&list);
+    index = (size_t)rand() % linkedlist_size(&model);
+    CHECK(linkedlist_skip_slice(&copy, index / 2, index) == 0);
+    linkedlist_slice(&model, index / 2, index);
+    check_count = 0;
+    CHECK(linkedlist_skip_foreach(&copy, check_append) == 0);
+    CHECK(check_same(&model));
+    if (!linkedlist_isempty(&model)) {
+        CHECK(linkedlist_skip_first(&copy) == linkedlist_first(&model));
+        CHECK(linkedlist_skip_last(&copy) == linkedlist_last(&model));
+    }
+
+    linkedlist_skip_destroy(&copy);
+    linkedlist_destroy(&model);
+    CHECK(linkedlist_skip_isempty(&copy));
+    return 0;
+}
+
+
+static int check_typed(void) {
+    intlist_t list, copy;
+    int array[CHECK_ITEMS], item, i;
+
+    /* Fill the list with odd numbers in descending order, and an even number
+     * in the middle.
+     */
+    intlist_create(&list);
+    for (i = 0; i < CHECK_ITEMS; i++) {
+        CHECK(intlist_unshift(&list, 2 * i + 1) == 0);
+    }
+    CHECK(intlist_set(&list, CHECK_ITEMS / 2, 4) == 0);
+    CHECK(intlist_size(&list) == CHECK_ITEMS);
+    CHECK(*intlist_first(&list) == 2 * CHECK_ITEMS - 1);
+    CHECK(*intlist_last(&list) == 1);
+    CHECK(*intlist_get(&list, CHECK_ITEMS / 2) == 4);
+
+    /* Find the even number, and nothing once it is gone. */
+    CHECK(*intlist_find(&list, check_intiseven) == 4);
+    CHECK(intlist_findindex(&list, check_intiseven) == CHECK_ITEMS / 2);
+    CHECK(intlist_remove(&list, CHECK_ITEMS / 2, &item) == 0 && item == 4);
+    CHECK(!intlist_find(&list, check_intiseven));
+    CHECK(intlist_findindex(&list, check_intiseven) == CHECK_ITEMS - 1);
+
+    /* Sort a copy, and keep the original. */
+    CHECK(intlist_clone(&list, &copy) == 0);
+    CHECK(intlist_sort(&copy, check_intcompare) == 0);
+    CHECK(intlist_toarray(&copy, array) == 0);
+    for (i = 1; i < CHECK_ITEMS - 1; i++) {
+        CHECK(array[i - 1] < array[i]);
+    }
+    CHECK(*intlist_first(&list) == 2 * CHECK_ITEMS - 1);
+
+    /* Add, sum and remove items from both ends. */
+    CHECK(intlist_add(&copy, 0, 0) == 0);
+    CHECK(intlist_push(&copy, 0) == 0);
+    check_sum = 0;
+    intlist_foreach(&copy, check_intadd);
+    CHECK(check_sum == (size_t)CHECK_ITEMS * CHECK_ITEMS - (CHECK_ITEMS - 1));
+    CHECK(intlist_shift(&copy, &item) == 0 && item == 0);
+    CHECK(intlist_pop(&copy, &item) == 0 && item == 0);
+    intlist_destroy(&copy);
+    intlist_destroy(&list);
+    CHECK(intlist_isempty(&list));
+    return 0;
+}
+
+
+static int check_persistent(void) {
+    linkedlist_persistent_t list, copy;
+    linkedlist_t model, modelcopy;
+    size_t i, index;
+    void *data;
+
+    /* Make the same random changes to the list and a model. */
+    linkedlist_persistent_create(&list);
+    linkedlist_create(&model);
+    for (i = 0; i < CHECK_CHANGES; i++) {
+        data = check_item();
+        index = (size_t)rand() % (linkedlist_size(&model) + 1);
+        switch (rand() % 6) {
+        case 0:
+            CHECK(linkedlist_persistent_push(&list, data) == 0);
+            linkedlist_push(&model, data);
+            break;
+        case 1:
+            CHECK(linkedlist_persistent_unshift(&list, data) == 0);
+            linkedlist_unshift(&model, data);
+            break;
+        case 2:
+            CHECK(linkedlist_persistent_add(&list, index, data) == 0);
+            linkedlist_add(&model, index, data);
+            break;
+        case 3:
+            if (index < linkedlist_size(&model)) {
+                CHECK(linkedlist_persistent_remove(&list, index)
+                    == linkedlist_remove(&model, index));
+            }
+            break;
+        case 4:
+            if (index < linkedlist_size(&model)) {
+                CHECK(linkedlist_persistent_set(&list, index, data) == 0);
+                linkedlist_set(&model, index, data);
+            }
+            break;
+        default:
+            if (!linkedlist_isempty(&model)) {
+                CHECK(linkedlist_persistent_pop(&list)
+                    == linkedlist_pop(&model));
+            }
+        }
+    }
+    CHECK(linkedlist_persistent_size(&list) == linkedlist_size(&model));
+    CHECK(linkedlist_persistent_toarray(&list, check_actual) == 0);
+    CHECK(check_same(&model));
+
+    /* Search both, starting with an item which fails the test. */
+    CHECK(linkedlist_persistent_unshift(&list, (void*)1) == 0);
+    linkedlist_unshift(&model, (void*)1);
+    data = check_item();
+    CHECK(linkedlist_persistent_indexof(&list, data)
+        == linkedlist_indexof(&model, data));
+    CHECK(linkedlist_persistent_find(&list, check_iseven)
+        == linkedlist_find(&model, check_iseven));
+    CHECK(linkedlist_persistent_findindex(&list, check_iseven)
+        == linkedlist_findindex(&model, check_iseven));
+
+    /* Change the list after cloning it, leaving the clone as it was. */
+    CHECK(linkedlist_persistent_clone(&list, &copy) == 0);
+    linkedlist_clone(&model, &modelcopy);
+    CHECK(linkedlist_persistent_push(&list, check_item()) == 0);
+    CHECK(linkedlist_persistent_set(&list, 0, NULL) == 0);
+    CHECK(linkedlist_persistent_shift(&list) == NULL);
+    CHECK(linkedlist_persistent_toarray(&copy, check_actual) == 0);
+    CHECK(check_same(&modelcopy));
+    CHECK(linkedlist_persistent_first(&copy) == linkedlist_first(&model));
+    CHECK(linkedlist_persistent_last(&copy) == linkedlist_last(&model));
+
+    linkedlist_persistent_destroy(&copy);
+    linkedlist_persistent_destroy(&list);
+    linkedlist_destroy(&modelcopy);
+    linkedlist_destroy(&model);
+    return 0;
+}
+
+
+static void *check_reader(void *arg) {
+    size_t i;
+
+    /* Read the list by position and search it, which must not change it. */
+    (void)arg;
+    for (i = 0; i < CHECK_ITEMS; i++) {
+        linkedlist_get(&check_list, i);
+        linkedlist_indexof(&check_list, linkedlist_last(&check_list));
+        linkedlist_find(&check_list, check_iseven);
+    }
+    return NULL;
+}
+
+static int check_linkedlist(void) {
+    pthread_t threads[CHECK_THREADS];
+    linkedlist_t copy;
+    size_t i, j;
+
+    /* Read a list which does not cache from several threads at once. */
+    linkedlist_create(&check_list);
+    for (i = 0; i < CHECK_ITEMS; i++) {
+        CHECK(linkedlist_push(&check_list, check_item()) == 0);
+    }
+    for (i = 0; i < CHECK_THREADS; i++) {
+        CHECK(pthread_create(&threads[i], NULL, check_reader, NULL) == 0);
+    }
+    for (i = 0; i < CHECK_THREADS; i++) {
+        pthread_join(threads[i], NULL);
+    }
+    CHECK(!check_list.finger && !check_list.snapshot);
+
+    /* Read the list again once it caches, to the same items. */
+    linkedlist_toarray(&check_list, check_expected);
+    CHECK(linkedlist_cache(&check_list, 1) == 0);
+    for (i = 0; i < CHECK_ITEMS; i++) {
+        CHECK(linkedlist_get(&check_list, i) == check_expected[i]);
+        j = 0;
+        while (check_expected[j] != check_expected[i]) {
+            j++;
+        }
+        CHECK(linkedlist_indexof(&check_list, check_expected[i]) == j);
+    }
+    CHECK(check_list.finger && check_list.snapshot);
+
+    /* Copy the list, which caches too, and free the memory kept for caching
+     * once it is turned off.
+     */
+    CHECK(linkedlist_clone(&check_list, &copy) == 0);
+    CHECK(copy.cache);
+    CHECK(linkedlist_cache(&check_list, 0) == 0);
+    CHECK(!check_list.finger && !check_list.snapshot);
+    CHECK(linkedlist_get(&check_list, CHECK_ITEMS / 2)
+        == linkedlist_get(&copy, CHECK_ITEMS / 2));
+
+    linkedlist_destroy(&copy);
+    linkedlist_destroy(&check_list);
+    return 0;
+}
+
+
+static int check_intrusive(void) {
+    linkedlist_intrusive_t list, rest;
+    linkedlist_t model, modelrest;
+    linkedlist_link_t *link;
+    size_t i, index;
+
+    /* Make the same random changes to the list and a model of its links, using
+     * each entry once.
+     */
+    linkedlist_intrusive_create(&list);
+    linkedlist_create(&model);
+    for (i = 0; i < CHECK_CHANGES; i++) {
+        check_entries[i].value = (uintptr_t)check_item();
+        link = &check_entries[i].link;
+        index = (size_t)rand() % (linkedlist_size(&model) + 1);
+        switch (rand() % 6) {
+        case 0:
+            CHECK(linkedlist_intrusive_push(&list, link) == 0);
+            linkedlist_push(&model, link);
+            break;
+        case 1:
+            CHECK(linkedlist_intrusive_unshift(&list, link) == 0);
+            linkedlist_unshift(&model, link);
+            break;
+        case 2:
+            CHECK(linkedlist_intrusive_add(&list, index, link) == 0);
+            linkedlist_add(&model, index, link);
+            break;
+        case 3:
+            if (index < linkedlist_size(&model)) {
+                CHECK(linkedlist_intrusive_remove(&list, index)
+                    == linkedlist_remove(&model, index));
+            }
+            break;
+        case 4:
+            if (index < linkedlist_size(&model)) {
+                link = (linkedlist_link_t*)linkedlist_remove(&model, index);
+                CHECK(linkedlist_intrusive_unlink(&list, link) == 0);
+            }
+            break;
+        default:
+            if (!linkedlist_isempty(&model)) {
+                CHECK(linkedlist_intrusive_shift(&list)
+                    == linkedlist_shift(&model));
+            }
+        }
+    }
+    CHECK(linkedlist_intrusive_size(&list) == linkedlist_size(&model));
+    check_count = 0;
+    CHECK(linkedlist_intrusive_foreach(&list, check_linkappend) == 0);
+    CHECK(check_same(&model));
+
+    /* Search both, starting with an item which fails the test. */
+    check_entries[CHECK_CHANGES].value = 1;
+    link = &check_entries[CHECK_CHANGES].link;
+    CHECK(linkedlist_intrusive_unshift(&list, link) == 0);
+    linkedlist_unshift(&model, link);
+    CHECK(linkedlist_intrusive_find(&list, check_linkiseven)
+        == linkedlist_find(&model, check_entryiseven));
+    CHECK(linkedlist_intrusive_findindex(&list, check_linkiseven)
+        == linkedlist_findindex(&model, check_entryiseven));
+    index = (size_t)rand() % linkedlist_size(&model);
+    link = (linkedlist_link_t*)linkedlist_get(&model, index);
+    CHECK(linkedlist_intrusive_get(&list, index) == link);
+    CHECK(linkedlist_intrusive_indexof(&list, link) == index);
+
+    /* Reverse, sort, split and slice both. */
+    CHECK(linkedlist_intrusive_reverse(&list) == 0);
+    linkedlist_reverse(&model);
+    CHECK(linkedlist_intrusive_sort(&list, check_linkcompare) == 0);
+    linkedlist_sort(&model, check_entrycompare);
+    CHECK(linkedlist_intrusive_split(&list, index, &rest) == 0);
+    linkedlist_split(&model, index, &modelrest);
+    CHECK(linkedlist_intrusive_slice(&rest, 1, CHECK_ITEMS) == 0);
+    linkedlist_slice(&modelrest, 1, CHECK_ITEMS);
+    check_count = 0;
+    CHECK(linkedlist_intrusive_foreachreverse(&rest, check_linkappend) == 0);
+    linkedlist_reverse(&modelrest);
+    CHECK(check_same(&modelrest));
+
+    /* Concatenate both. */
+    linkedlist_reverse(&modelrest);
+    CHECK(linkedlist_intrusive_concat(&list, &rest) == 0);
+    CHECK(linkedlist_intrusive_isempty(&rest));
+    linkedlist_concat(&model, &modelrest);
+    check_count = 0;
+    CHECK(linkedlist_intrusive_foreach(&list, check_linkappend) == 0);
+    CHECK(check_same(&model));
+    CHECK(linkedlist_intrusive_first(&list) == linkedlist_first(&model));
+    CHECK(linkedlist_intrusive_last(&list) == linkedlist_last(&model));
+
+    linkedlist_intrusive_destroy(&list);
+    linkedlist_destroy(&modelrest);
+    linkedlist_destroy(&model);
+    CHECK(linkedlist_intrusive_isempty(&list));
+    return 0;
+}
+
+
+static int check_packed(void) {
+    linkedlist_packed_t list, copy;
+    linkedlist_t model;
+    size_t i, index;
+    void *data;
+
+    /* Make the same random changes to the list and a model. */
+    linkedlist_packed_create(&list);
+    linkedlist_create(&model);
+    CHECK(linkedlist_packed_reserve(&list, CHECK_ITEMS) == 0);
+    for (i = 0; i < CHECK_CHANGES; i++) {
+        data = check_item();
+        index = (size_t)rand() % (linkedlist_size(&model) + 1);
+        switch (rand() % 7) {
+        case 0:
+            CHECK(linkedlist_packed_push(&list, data) == 0);
+            linkedlist_push(&model, data);
+            break;
+        case 1:
+            CHECK(linkedlist_packed_unshift(&list, data) == 0);
+            linkedlist_unshift(&model, data);
+            break;
+        case 2:
+            CHECK(linkedlist_packed_add(&list, index, data) == 0);
+            linkedlist_add(&model, index, data);
+            break;
+        case 3:
+            if (index < linkedlist_size(&model)) {
+                CHECK(linkedlist_packed_remove(&list, index)
+                    == linkedlist_remove(&model, index));
+            }
+            break;
+        case 4:
+            if (index < linkedlist_size(&model)) {
+                CHECK(linkedlist_packed_set(&list, index, data) == 0);
+                linkedlist_set(&model, index, data);
+            }
+            break;
+        case 5:
+            if (!linkedlist_isempty(&model)) {
+                CHECK(linkedlist_packed_shift(&list)
+                    == linkedlist_shift(&model));
+            }
+            break;
+        default:
+            if (!linkedlist_isempty(&model)) {
+                CHECK(linkedlist_packed_pop(&list)
+                    == linkedlist_pop(&model));
+            }
+        }
+    }
+    CHECK(linkedlist_packed_size(&list) == linkedlist_size(&model));
+    CHECK(linkedlist_packed_toarray(&list, check_actual) == 0);
+    check_actual[linkedlist_size(&model)] = NULL;
+    CHECK(check_same(&model));
+
+    /* Search both, starting with an item which fails the test. */
+    CHECK(linkedlist_packed_unshift(&list, (void*)1) == 0);
+    linkedlist_unshift(&model, (void*)1);
+    data = check_item();
+    CHECK(linkedlist_packed_indexof(&list, data)
+        == linkedlist_indexof(&model, data));
+    CHECK(linkedlist_packed_findindex(&list, check_iseven)
+        == linkedlist_findindex(&model, check_iseven));
+    index = (size_t)rand() % linkedlist_size(&model);
+    CHECK(linkedlist_packed_get(&list, index)
+        == linkedlist_get(&model, index));
+
+    /* Copy the list, and visit every item of the copy. */
+    CHECK(linkedlist_packed_clone(&list, &copy) == 0);
+    linkedlist_packed_destroy(&list);
+    check_count = 0;
+    CHECK(linkedlist_packed_foreach(&copy, check_append) == 0);
+    CHECK(check_same(&model));
+    CHECK(linkedlist_packed_first(&copy) == linkedlist_first(&model));
+    CHECK(linkedlist_packed_last(&copy) == linkedlist_last(&model));
+
+    linkedlist_packed_destroy(&copy);
+    linkedlist_destroy(&model);
+    CHECK(linkedlist_packed_isempty(&copy));
+    return 0;
+}
+
+
+static void *check_rcureader(void *arg) {
+    linkedlist_rcu_reader_t reader;
+    int *failed = (int*)arg;
+    size_t i;
+    void *data;
+
+    /* Find an item while the list changes, which must pass the test. */
+    linkedlist_rcu_register(&check_rculist, &reader);
+    for (i = 0; i < CHECK_CHANGES; i++) {
+        data = linkedlist_rcu_find(&reader, check_iseven);
+        if (data && check_iseven(data) != 1) {
+            *failed = 1;
+        }
+    }
+    linkedlist_rcu_unregister(&reader);
+    return NULL;
+}
+
+static int check_query(void) {
+    linkedlist_query_t query;
+    linkedlist_t list, model, dest;
+    size_t i, total = 0;
+
+    /* Query the even items of 1 to CHECK_ITEMS, doubled, from the 11th to the
+     * 110th.
+     */
+    linkedlist_create(&list);
+    linkedlist_create(&model);
+    for (i = 1; i <= CHECK_ITEMS; i++) {
+        CHECK(linkedlist_push(&list, (void*)(uintptr_t)i) == 0);
+    }
+    for (i = 11; i <= 110; i++) {
+        CHECK(linkedlist_push(&model, (void*)(uintptr_t)(4 * i)) == 0);
+    }
+    CHECK(linkedlist_query_create(&query, &list) == 0);
+    CHECK(linkedlist_query_filter(&query, check_iseven) == 0);
+    CHECK(linkedlist_query_map(&query, check_double) == 0);
+    CHECK(linkedlist_query_skip(&query, 10) == 0);
+    CHECK(linkedlist_query_take(&query, 100) == 0);
+
+    /* Run the query each way. */
+    check_count = 0;
+    check_actual[0] = NULL;
+    CHECK(linkedlist_query_foreach(&query, check_append) == 0);
+    CHECK(check_same(&model));
+    CHECK(linkedlist_query_collect(&query, &dest, NULL) == 0);
+    CHECK(linkedlist_toarray(&dest, check_actual) == 0);
+    CHECK(check_same(&model));
+    CHECK(linkedlist_query_reduce(&query, check_accumulate, &total) == 0);
+    CHECK(total == 4 * (11 + 110) * 100 / 2);
+    CHECK(linkedlist_size(&list) == CHECK_ITEMS);
+
+    linkedlist_destroy(&dest);
+    linkedlist_destroy(&model);
+    linkedlist_destroy(&list);
+    return 0;
+}
+
+
+static void *check_producer(void *arg) {
+    size_t producer = *(size_t*)arg, i;
+
+    /* Push items numbered in order after the producer's number. */
+    for (i = 1; i <= CHECK_CHANGES; i++) {
+        linkedlist_queue_push(&check_queuelist,
+            (void*)(uintptr_t)(producer * CHECK_CHANGES + i));
+    }
+    return NULL;
+}
+
+static void *check_consumer(void *arg) {
+    size_t last[CHECK_THREADS / 2] = { 0 }, producer, item;
+    int *failed = (int*)arg;
+    void *data;
+
+    /* Shift items until every item is shifted. Each producer's items must
+     * come in the order they were pushed.
+     */
+    while (atomic_load(&check_shifted) < CHECK_THREADS / 2 * CHECK_CHANGES) {
+        data = linkedlist_queue_shift(&check_queuelist);
+        if (!data) {
+            continue;
+        }
+        producer = ((uintptr_t)data - 1) / CHECK_CHANGES;
+        item = ((uintptr_t)data - 1) % CHECK_CHANGES + 1;
+        if (producer >= CHECK_THREADS / 2 || item <= last[producer]) {
+            *failed = 1;
+        } else {
+            last[producer] = item;
+        }
+        atomic_fetch_add(&check_atomictotal, (uintptr_t)data);
+        atomic_fetch_add(&check_shifted, 1);
+    }
+    return NULL;
+}
+
+static int check_queue(void) {
+    pthread_t threads[CHECK_THREADS];
+    int failed[CHECK_THREADS] = { 0 };
+    size_t i, items = CHECK_THREADS / 2 * CHECK_CHANGES;
+
+    /* Push and shift one item. */
+    CHECK(linkedlist_queue_create(&check_queuelist) == 0);
+    CHECK(linkedlist_queue_isempty(&check_queuelist));
+    CHECK(linkedlist_queue_push(&check_queuelist, (void*)1) == 0);
+    CHECK(linkedlist_queue_size(&check_queuelist) == 1);
+    CHECK(linkedlist_queue_shift(&check_queuelist) == (void*)1);
+    CHECK(!linkedlist_queue_shift(&check_queuelist));
+
+    /* Push from half the threads while the others shift every item. */
+    atomic_store(&check_shifted, 0);
+    atomic_store(&check_atomictotal, 0);
+    for (i = 0; i < CHECK_THREADS; i++) {
+        check_numbers[i] = i / 2;
+        if (i % 2) {
+            CHECK(pthread_create(&threads[i], NULL, check_consumer,
+                &failed[i]) == 0);
+        } else {
+            CHECK(pthread_create(&threads[i], NULL, check_producer,
+                &check_numbers[i]) == 0);
+        }
+    }
+    for (i = 0; i < CHECK_THREADS; i++) {
+        pthread_join(threads[i], NULL);
+        CHECK(!failed[i]);
+    }
+    CHECK(atomic_load(&check_atomictotal) == items * (items + 1) / 2);
+    CHECK(linkedlist_queue_isempty(&check_queuelist));
+
+    linkedlist_queue_destroy(&check_queuelist);
+    return 0;
+}
+
+
+static int check_rcu(void) {
+    linkedlist_rcu_reader_t reader;
+    linkedlist_t model;
+    pthread_t threads[CHECK_THREADS];
+    int failed[CHECK_THREADS] = { 0 };
+    size_t i, index;
+    void *data;
+
+    /* Make the same random changes to the list and a model. */
+    linkedlist_rcu_create(&check_rculist);
+    linkedlist_rcu_register(&check_rculist, &reader);
+    linkedlist_create(&model);
+    for (i = 0; i < CHECK_CHANGES; i++) {
+        data = check_item();
+        index = (size_t)rand() % (linkedlist_size(&model) + 1);
+        switch (rand() % 6) {
+        case 0:
+            CHECK(linkedlist_rcu_push(&check_rculist, data) == 0);
+            linkedlist_push(&model, data);
+            break;
+        case 1:
+            CHECK(linkedlist_rcu_unshift(&check_rculist, data) == 0);
+            linkedlist_unshift(&model, data);
+            break;
+        case 2:
+            CHECK(linkedlist_rcu_add(&check_rculist, index, data) == 0);
+            linkedlist_add(&model, index, data);
+            break;
+        case 3:
+            if (index < linkedlist_size(&model)) {
+                CHECK(linkedlist_rcu_remove(&check_rculist, index)
+                    == linkedlist_remove(&model, index));
+            }
+            break;
+        case 4:
+            if (index < linkedlist_size(&model)) {
+                CHECK(linkedlist_rcu_set(&check_rculist, index, data) == 0);
+                linkedlist_set(&model, index, data);
+            }
+            break;
+        default:
+            if (!linkedlist_isempty(&model)) {
+                CHECK(linkedlist_rcu_pop(&check_rculist)
+                    == linkedlist_pop(&model));
+            }
+        }
+    }
+    CHECK(linkedlist_rcu_size(&check_rculist) == linkedlist_size(&model));
+    check_count = 0;
+    CHECK(linkedlist_rcu_foreach(&reader, check_append) == 0);
+    CHECK(check_same(&model));
+
+    /* Search both, starting with an item which fails the test. */
+    CHECK(linkedlist_rcu_unshift(&check_rculist, (void*)1) == 0);
+    linkedlist_unshift(&model, (void*)1);
+    data = check_item();
+    CHECK(linkedlist_rcu_indexof(&reader, data)
+        == linkedlist_indexof(&model, data));
+    CHECK(linkedlist_rcu_find(&reader, check_iseven)
+        == linkedlist_find(&model, check_iseven));
+    CHECK(linkedlist_rcu_findindex(&reader, check_iseven)
+        == linkedlist_findindex(&model, check_iseven));
+    index = (size_t)rand() % linkedlist_size(&model);
+    CHECK(linkedlist_rcu_get(&reader, index)
+        == linkedlist_get(&model, index));
+    linkedlist_rcu_unregister(&reader);
+
+    /* Search the list from other threads while changing it. */
+    for (i = 0; i < CHECK_THREADS; i++) {
+        CHECK(pthread_create(&threads[i], NULL, check_rcureader, &failed[i])
+            == 0);
+    }
+    for (i = 0; i < CHECK_CHANGES; i++) {
+        index = (size_t)rand() % linkedlist_rcu_size(&check_rculist);
+        linkedlist_rcu_set(&check_rculist, index, check_item());
+        linkedlist_rcu_push(&check_rculist, check_item());
+        linkedlist_rcu_shift(&check_rculist);
+    }
+    for (i = 0; i < CHECK_THREADS; i++) {
+        pthread_join(threads[i], NULL);
+        CHECK(!failed[i]);
+    }
+
+    linkedlist_rcu_destroy(&check_rculist);
+    linkedlist_destroy(&model);
+    return 0;
+}
+
+
+static int check_parallel(void) {
+    linkedlist_workers_t workers;
+    linkedlist_t list, copy;
+    void **expected, **actual;
+    size_t i, size = LINKEDLIST_PARALLEL_SORT + CHECK_ITEMS;
+
+    /* Fill a list long enough to be sorted by several threads, starting with
+     * an item which fails the test.
+     */
+    CHECK(linkedlist_workers_create(&workers, CHECK_THREADS - 1) == 0);
+    linkedlist_create(&list);
+    CHECK(linkedlist_push(&list, (void*)1) == 0);
+    for (i = 1; i < size; i++) {
+        CHECK(linkedlist_push(&list, check_item()) == 0);
+    }
+
+    /* Sum and search the list with the workers and without. */
+    check_total = 0;
+    atomic_store(&check_atomictotal, 0);
+    linkedlist_foreach(&list, check_add);
+    CHECK(linkedlist_foreachparallel(&list, &workers, check_atomicadd) == 0);
+    CHECK(atomic_load(&check_atomictotal) == check_total);
+    CHECK(linkedlist_findparallel(&list, &workers, check_iseven)
+        == linkedlist_find(&list, check_iseven));
+    CHECK(linkedlist_findindexparallel(&list, &workers, check_iseven)
+        == linkedlist_findindex(&list, check_iseven));
+    CHECK(!list.checkpoints);
+
+    /* Search the list again as pushes grow its last segment, keeping its
+     * checkpoints.
+     */
+    CHECK(linkedlist_cache(&list, 1) == 0);
+    for (i = 0; i < CHECK_ITEMS; i++) {
+        CHECK(linkedlist_findindexparallel(&list, &workers, check_islast)
+            == linkedlist_size(&list));
+        CHECK(linkedlist_push(&list, check_item()) == 0);
+        CHECK(linkedlist_push(&list, check_item()) == 0);
+    }
+    CHECK(linkedlist_push(&list, (void*)(CHECK_ITEMS + 1)) == 0);
+    CHECK(linkedlist_findindexparallel(&list, &workers, check_islast)
+        == linkedlist_size(&list) - 1);
+
+    /* Sort the list with the workers, and a copy without. */
+    size = linkedlist_size(&list);
+    expected = (void**)malloc((size + 1) * sizeof *expected);
+    actual = (void**)malloc((size + 1) * sizeof *actual);
+    CHECK(expected && actual);
+    CHECK(linkedlist_clone(&list, &copy) == 0);
+    CHECK(linkedlist_sortparallel(&list, &workers, check_compare) == 0);
+    CHECK(linkedlist_sort(&copy, check_compare) == 0);
+    linkedlist_toarray(&list, actual);
+    linkedlist_toarray(&copy, expected);
+    for (i = 0; i < size; i++) {
+        CHECK(actual[i] == expected[i]);
+    }
+
+    free(actual);
+    free(expected);
+    linkedlist_destroy(&copy);
+    linkedlist_destroy(&list);
+    CHECK(linkedlist_workers_destroy(&workers) == 0);
+    return 0;
+}
+
+
+static int check_unrolled(void) {
+    linkedlist_unrolled_t list, copy;
+    linkedlist_t model, modelcopy;
+    void *keys[4];
+    size_t i, index;
+    void *data;
+
+    /* Make the same random changes to the list and a model. */
+    linkedlist_unrolled_create(&list);
+    linkedlist_create(&model);
+    for (i = 0; i < CHECK_CHANGES; i++) {
+        data = check_item();
+        index = (size_t)rand() % (linkedlist_size(&model) + 1);
+        keys[0] = check_item();
+        keys[1] = check_item();
+        keys[2] = data;
+        keys[3] = NULL;
+        switch (rand() % 10) {
+        case 0:
+            CHECK(linkedlist_unrolled_push(&list, data) == 0);
+            linkedlist_push(&model, data);
+            break;
+        case 1:
+            CHECK(linkedlist_unrolled_unshift(&list, data) == 0);
+            linkedlist_unshift(&model, data);
+            break;
+        case 2:
+            CHECK(linkedlist_unrolled_add(&list, index, data) == 0);
+            linkedlist_add(&model, index, data);
+            break;
+        case 3:
+            if (index < linkedlist_size(&model)) {
+                CHECK(linkedlist_unrolled_remove(&list, index)
+                    == linkedlist_remove(&model, index));
+            }
+            break;
+        case 4:
+            if (index < linkedlist_size(&model)) {
+                CHECK(linkedlist_unrolled_set(&list, index, data) == 0);
+                linkedlist_set(&model, index, data);
+            }
+            break;
+        case 5:
+            CHECK(linkedlist_unrolled_addarray(&list, keys) == 0);
+            linkedlist_addarray(&model, keys);
+            break;
+        case 6:
+            CHECK(linkedlist_unrolled_removearray(&list, keys) == 0);
+            linkedlist_removearray(&model, keys);
+            break;
+        case 7:
+            CHECK(linkedlist_unrolled_removearrayall(&list, keys) == 0);
+            linkedlist_removearrayall(&model, keys);
+            break;
+        case 8:
+            if (!linkedlist_isempty(&model)) {
+                CHECK(linkedlist_unrolled_pop(&list)
+                    == linkedlist_pop(&model));
+            }
+            break;
+        default:
+            if (!linkedlist_isempty(&model)) {
+                CHECK(linkedlist_unrolled_shift(&list)
+                    == linkedlist_shift(&model));
+            }
+        }
+    }
+    CHECK(linkedlist_unrolled_size(&list) == linkedlist_size(&model));
+    CHECK(linkedlist_unrolled_toarray(&list, check_actual) == 0);
+    CHECK(check_same(&model));
+
+    /* Search both, starting with an item which fails the test. */
+    CHECK(linkedlist_unrolled_unshift(&list, (void*)1) == 0);
+    linkedlist_unshift(&model, (void*)1);
+    data = check_item();
+    CHECK(linkedlist_unrolled_indexof(&list, data)
+        == linkedlist_indexof(&model, data));
+    CHECK(linkedlist_unrolled_find(&list, check_iseven)
+        == linkedlist_find(&model, check_iseven));
+    CHECK(linkedlist_unrolled_findindex(&list, check_iseven)
+        == linkedlist_findindex(&model, check_iseven));
+    index = (size_t)rand() % linkedlist_size(&model);
+    CHECK(linkedlist_unrolled_get(&list, index)
+        == linkedlist_get(&model, index));
+
+    /* Reverse and sort both, then add and remove the items of copies. */
+    CHECK(linkedlist_unrolled_reverse(&list) == 0);
+    linkedlist_reverse(&model);
+    CHECK(linkedlist_unrolled_clone(&list, &copy) == 0);
+    linkedlist_clone(&model, &modelcopy);
+    CHECK(linkedlist_unrolled_sort(&list, check_compare) == 0);
+    linkedlist_sort(&model, check_compare);
+    CHECK(linkedlist_unrolled_addlinkedlist(&list, &copy) == 0);
+    linkedlist_addlinkedlist(&model, &modelcopy);
+    CHECK(linkedlist_unrolled_slice(&copy, index / 2, index) == 0);
+    linkedlist_slice(&modelcopy, index / 2, index);
+    CHECK(linkedlist_unrolled_removelinkedlist(&list, &copy) == 0);
+    linkedlist_removelinkedlist(&model, &modelcopy);
+    CHECK(linkedlist_unrolled_toarray(&list, check_actual) == 0);
+    CHECK(check_same(&model));
+    CHECK(linkedlist_unrolled_removelinkedlistall(&list, &copy) == 0);
+    linkedlist_removelinkedlistall(&model, &modelcopy);
+    check_count = 0;
+    CHECK(linkedlist_unrolled_foreach(&list, check_append) == 0);
+    CHECK(check_same(&model));
+    CHECK(linkedlist_unrolled_first(&list) == linkedlist_first(&model));
+    CHECK(linkedlist_unrolled_last(&list) == linkedlist_last(&model));
+
+    linkedlist_unrolled_destroy(&copy);
+    linkedlist_unrolled_destroy(&list);
+    linkedlist_destroy(&modelcopy);
+    linkedlist_destroy(&model);
+    CHECK(linkedlist_unrolled_isempty(&list));
+    return 0;
+}
+
+
+/* Name, check. */
+static const struct {
+    const char *name;
+    int (*check)(void);
+} checks[] = {
+    { "linkedlist", check_linkedlist },
+    { "linkedlist_intrusive", check_intrusive },
+    { "linkedlist_packed", check_packed },
+    { "linkedlist_parallel", check_parallel },
+    { "linkedlist_persistent", check_persistent },
+    { "linkedlist_query", check_query },
+    { "linkedlist_queue", check_queue },
+    { "linkedlist_rcu", check_rcu },
+    { "linkedlist_sharded", check_sharded },
+    { "linkedlist_skip", check_skip },
+    { "linkedlist_typed", check_typed },
+    { "linkedlist_unrolled", check_unrolled }
+};
+
+int main(void) {
+    size_t i;
+    int failed = 0;
+
+    for (i = 0; i < sizeof checks / sizeof checks[0]; i++) {
+        if (checks[i].check()) {
+            printf(" %s failed\n", checks[i].name);
+            failed = 1;
+        } else {
+            printf(" %s ok\n", checks[i].name);
+        }
+    }
+    return failed;
+}
@@ -1,101 +1,613 @@
 /*
  * linkedlist.c
- * Version 20161001
+ * Version 20261018
  * Written by Harry Wong (RedAndBlueEraser)
  */
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
 #include "linkedlist.h"
 
-int linkedlist_create(linkedlist_t *list) {
-    /* Initialise list attributes. */
-    list->head = list->foot = NULL;
-    list->size = 0;
+#ifndef LINKEDLIST_POOL_CHUNKSIZE
+#define LINKEDLIST_POOL_CHUNKSIZE 256
+#endif
+
+/* Number of times searches walk the length of the list, in a row without the
+ * list changing, before the items are packed into an array to search instead
+ * of walking the list. Packing takes one more walk, so it at most doubles the
+ * time spent searching a list which changes often. 0 turns packing off.
+ */
+#ifndef LINKEDLIST_SNAPSHOT_WALKS
+#define LINKEDLIST_SNAPSHOT_WALKS 1
+#endif
+
+/* Bytes read or written at a time by linkedlist_load() and linkedlist_save().
+ */
+#ifndef LINKEDLIST_IO_BUFFER
+#define LINKEDLIST_IO_BUFFER 65536
+#endif
+
+/* Number of nodes ahead of the current node which walks calling a function on
+ * each item prefetch, so that fetching them overlaps the calls. 0 turns
+ * prefetching off.
+ */
+#ifndef LINKEDLIST_PREFETCH
+#define LINKEDLIST_PREFETCH 8
+#endif
+
+/* Most items searched for at once by comparison rather than a hash table. */
+#define SEARCHKEYS 16
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#include <immintrin.h>
+#define LINKEDLIST_SIMD
+#endif
+
+#if defined(__GNUC__) && LINKEDLIST_PREFETCH > 0
+#define LINKEDLIST_PREFETCHING
+#endif
+
+/* Instrumentation, which compiles to nothing unless LINKEDLIST_STATS is
+ * defined.
+ */
+#ifdef LINKEDLIST_STATS
+#define LINKEDLIST_CLEAR(list) linkedlist_stats_reset(list)
+#define LINKEDLIST_BEGIN(list, op, index) \
+    linkedlist_stats_begin(list, op, index)
+#define LINKEDLIST_WALK(list, n) linkedlist_stats_walk(list, n)
+#define LINKEDLIST_ALLOC(list, n) ((list)->stats.allocs += (n))
+#define LINKEDLIST_FREE(list, n) ((list)->stats.frees += (n))
+#else
+#define LINKEDLIST_CLEAR(list) ((void)0)
+#define LINKEDLIST_BEGIN(list, op, index) ((void)0)
+#define LINKEDLIST_WALK(list, n) ((void)(list))
+#define LINKEDLIST_ALLOC(list, n) ((void)0)
+#define LINKEDLIST_FREE(list, n) ((void)0)
+#endif
+
+#ifdef LINKEDLIST_STATS
+static const char *linkedlist_stats_names[LINKEDLIST_OPS] = {
+    "create", "createpooled", "destroy", "clone", "size", "isempty", "push",
+    "pop", "unshift", "shift", "pushn", "popn", "shiftn", "add", "remove",
+    "set", "addarray", "removearray", "removearrayall", "addlinkedlist",
+    "removelinkedlist", "removelinkedlistall", "concat", "splice", "get",
+    "first", "last", "indexof", "indexofany", "find", "findindex",
+    "foreach", "foreachreverse", "cursor_begin", "cursor_beginreverse",
+    "cursor_isend", "cursor_next", "cursor_prev", "cursor_index",
+    "cursor_get", "cursor_set", "cursor_insertafter", "cursor_remove",
+    "view_create", "view_fromcursor", "view_size", "view_indexof",
+    "view_find", "view_foreach", "view_toarray",
+    "slice", "split", "rotate", "toarray", "save", "load", "reverse", "sort",
+    "sortkey", "compact", "invalidate", "cache"
+};
+
+static size_t linkedlist_stats_threshold = SIZE_MAX;
+static void (*linkedlist_stats_hook)(linkedlist_t *, const char *, size_t,
+    size_t);
+
+static void linkedlist_stats_begin(linkedlist_t *list, linkedlist_op_t op,
+    size_t index) {
+    /* Count call and start counting its walk. */
+    list->stats.calls[op]++;
+    list->stats.op = op;
+    list->stats.index = index;
+    list->stats.walk = 0;
+}
+
+static void linkedlist_stats_walk(linkedlist_t *list, size_t n) {
+    linkedlist_stats_t *stats = &list->stats;
+    size_t walk = stats->walk;
+
+    stats->walk += n;
+    stats->traversed += n;
+    if (stats->walk > stats->maxwalk) {
+        stats->maxwalk = stats->walk;
+    }
+
+    /* Report the call once its walk reaches the threshold. */
+    if (linkedlist_stats_hook && walk < linkedlist_stats_threshold
+        && stats->walk >= linkedlist_stats_threshold) {
+        linkedlist_stats_hook(list, linkedlist_stats_names[stats->op],
+            stats->index, list->size);
+    }
+}
+
+int linkedlist_stats_get(linkedlist_t *list, linkedlist_stats_t *stats) {
+    linkedlist_chunk_t *chunk;
+
+    *stats = list->stats;
+
+    /* Count memory held by nodes (or the list's own pool) and packed items. */
+    if (list->ownspool && list->pool) {
+        stats->bytes = sizeof *list->pool;
+        for (chunk = list->pool->chunks; chunk; chunk = chunk->next) {
+            stats->bytes += sizeof *chunk
+                + sizeof chunk->nodes[0] * chunk->size;
+        }
+    } else {
+        stats->bytes = list->size * sizeof(linkedlist_node_t);
+    }
+    stats->bytes += list->snapshotcapacity * sizeof(void *);
     return 0;
 }
 
-int linkedlist_destroy(linkedlist_t *list) {
-    /* Free memory allocated for nodes in the list. */
-    linkedlist_node_t *curr = list->head, *next;
+int linkedlist_stats_reset(linkedlist_t *list) {
+    memset(&list->stats, 0, sizeof list->stats);
+    return 0;
+}
+
+int linkedlist_stats_sethook(size_t walk, void (*f)(linkedlist_t *list,
+    const char *op, size_t index, size_t size)) {
+    linkedlist_stats_threshold = walk;
+    linkedlist_stats_hook = f;
+    return 0;
+}
+#endif
+
+int linkedlist_pool_create(linkedlist_pool_t *pool, size_t chunksize) {
+    /* Initialise pool attributes. */
+    pool->chunks = NULL;
+    pool->free = NULL;
+    pool->chunksize = chunksize > 0 ? chunksize : LINKEDLIST_POOL_CHUNKSIZE;
+    pool->carved = 0;
+    return 0;
+}
+
+int linkedlist_pool_destroy(linkedlist_pool_t *pool) {
+    /* Free memory allocated for chunks in the pool. */
+    linkedlist_chunk_t *curr = pool->chunks, *next;
     while (curr) {
         next = curr->next;
         free(curr);
         curr = next;
     }
 
-    /* Create a new empty list. */
-    return linkedlist_create(list);
+    /* Create a new empty pool. */
+    return linkedlist_pool_create(pool, pool->chunksize);
 }
 
-int linkedlist_clone(linkedlist_t *src, linkedlist_t *dest) {
-    linkedlist_node_t *srccurr, *destcurr, *destprev;
+static linkedlist_node_t *linkedlist_pool_alloc(linkedlist_pool_t *pool) {
+    linkedlist_node_t *node;
+    linkedlist_chunk_t *chunk;
+
+    /* Reuse a freed node. */
+    if (pool->free) {
+        node = pool->free;
+        pool->free = node->next;
+        return node;
+    }
 
-    /* Create a new empty list for dest. */
-    linkedlist_create(dest);
+    /* Allocate a new chunk once the newest chunk is used up. */
+    if (!pool->chunks || pool->carved == pool->chunks->size) {
+        chunk = (linkedlist_chunk_t*)malloc(sizeof *chunk
+            + sizeof chunk->nodes[0] * pool->chunksize);
+        if (!chunk) {
+            return NULL;
+        }
+        chunk->next = pool->chunks;
+        chunk->size = pool->chunksize;
+        pool->chunks = chunk;
+        pool->carved = 0;
+    }
 
-    /* Copy nodes from src to dest. */
-    if (src->size == 0) {
+    /* Carve node from the newest chunk. */
+    return &pool->chunks->nodes[pool->carved++];
+}
+
+static linkedlist_node_t *linkedlist_node_alloc(linkedlist_t *list) {
+    linkedlist_node_t *node = NULL;
+
+    /* Create the list's own pool on first use. */
+    if (list->ownspool && !list->pool) {
+        list->pool = (linkedlist_pool_t*)malloc(sizeof *list->pool);
+        if (list->pool) {
+            linkedlist_pool_create(list->pool, 0);
+        }
+    }
+
+    if (list->pool) {
+        node = linkedlist_pool_alloc(list->pool);
+    } else if (!list->ownspool) {
+        node = (linkedlist_node_t*)malloc(sizeof *node);
+    }
+    if (!node) {
+        fprintf(stderr, "Out of memory\n");
+        return NULL;
+    }
+    LINKEDLIST_ALLOC(list, 1);
+    return node;
+}
+
+static void linkedlist_node_freechain(linkedlist_t *list,
+    linkedlist_node_t *head, linkedlist_node_t *foot, size_t count) {
+    linkedlist_node_t *next;
+
+    LINKEDLIST_FREE(list, count);
+
+    /* Return the chain to the pool's free list at once. */
+    if (list->pool) {
+        if (count > 0) {
+            foot->next = list->pool->free;
+            list->pool->free = head;
+        }
+    } else {
+        while (count-- > 0) {
+            next = head->next;
+            free(head);
+            head = next;
+        }
+    }
+}
+
+static void linkedlist_node_free(linkedlist_t *list, linkedlist_node_t *node) {
+    LINKEDLIST_FREE(list, 1);
+
+    /* Return node to the pool's free list. */
+    if (list->pool) {
+        node->next = list->pool->free;
+        list->pool->free = node;
     } else {
-        /* Copy head node from src to dest. */
-        srccurr = src->head;
+        free(node);
+    }
+}
+
+static linkedlist_node_t *linkedlist_node_allocchain(linkedlist_t *list,
+    size_t count) {
+    linkedlist_node_t head, *tail = &head, *next;
+    linkedlist_pool_t *pool;
+    linkedlist_chunk_t *chunk;
+    size_t size, i;
+
+    /* Without a pool, each node is allocated on its own to be freed on its
+     * own.
+     */
+    head.next = NULL;
+    if (!list->ownspool && !list->pool) {
+        for (i = 0; i < count; i++) {
+            next = linkedlist_node_alloc(list);
+            if (!next) {
+                linkedlist_node_freechain(list, head.next, tail, i);
+                return NULL;
+            }
+            tail->next = next;
+            tail = next;
+        }
+        tail->next = NULL;
+        return head.next;
+    }
 
-        destcurr = (linkedlist_node_t*)malloc(sizeof *destcurr);
-        if (!destcurr) {
+    /* Create the list's own pool on first use. */
+    if (!list->pool) {
+        list->pool = (linkedlist_pool_t*)malloc(sizeof *list->pool);
+        if (!list->pool) {
             fprintf(stderr, "Out of memory\n");
-            return 1;
+            return NULL;
         }
-        destcurr->next = NULL;
-        destcurr->data = srccurr->data;
+        linkedlist_pool_create(list->pool, 0);
+    }
+    pool = list->pool;
+
+    /* Reuse freed nodes, then carve the rest of the newest chunk. */
+    i = count;
+    while (i > 0 && pool->free) {
+        tail->next = pool->free;
+        tail = tail->next;
+        pool->free = tail->next;
+        i--;
+    }
+    while (i > 0 && pool->chunks && pool->carved < pool->chunks->size) {
+        tail->next = &pool->chunks->nodes[pool->carved++];
+        tail = tail->next;
+        i--;
+    }
+
+    /* Carve any remaining nodes from one new chunk, unless its size cannot
+     * be represented.
+     */
+    if (i > 0) {
+        size = i > pool->chunksize ? i : pool->chunksize;
+        chunk = size > (SIZE_MAX - sizeof *chunk) / sizeof chunk->nodes[0]
+            ? NULL : (linkedlist_chunk_t*)malloc(sizeof *chunk
+            + sizeof chunk->nodes[0] * size);
+        if (!chunk) {
+            /* Return the nodes taken to the free list. */
+            tail->next = pool->free;
+            pool->free = head.next;
+            fprintf(stderr, "Out of memory\n");
+            return NULL;
+        }
+        chunk->next = pool->chunks;
+        chunk->size = size;
+        pool->chunks = chunk;
+        pool->carved = 0;
+        while (i-- > 0) {
+            tail->next = &chunk->nodes[pool->carved++];
+            tail = tail->next;
+        }
+    }
+    tail->next = NULL;
+    LINKEDLIST_ALLOC(list, count);
+    return head.next;
+}
 
-        dest->head = destcurr;
+static void linkedlist_forgetsnapshot(linkedlist_t *list) {
+    /* Forget the packed items once any item may change. */
+    list->searches = 0;
+}
 
-        destprev = destcurr;
-        srccurr = srccurr->next;
+static void linkedlist_forgetcheckpoints(linkedlist_t *list) {
+    /* Forget the split checkpoints once nodes before the foot may change. */
+    list->checkpointcount = 0;
+    linkedlist_forgetsnapshot(list);
+}
+
+static void linkedlist_forget(linkedlist_t *list) {
+    /* Forget the last accessed node once its index may have changed. */
+    list->finger = NULL;
+    linkedlist_forgetcheckpoints(list);
+}
+
+static void linkedlist_remember(linkedlist_t *list, linkedlist_node_t *node,
+    size_t index) {
+    /* Remember node for the next access, if the list caches. */
+    if (list->cache) {
+        list->finger = node;
+        list->fingerindex = index;
+    }
+}
+
+static void linkedlist_reset(linkedlist_t *list) {
+    /* Reset list attributes, keeping the pool. */
+    list->head = list->foot = NULL;
+    list->size = 0;
+    linkedlist_forget(list);
+}
+
+static linkedlist_node_t *linkedlist_node_at(linkedlist_t *list, size_t index) {
+    linkedlist_node_t *curr;
+    size_t i;
+
+    /* Start from whichever end of the list is closer, or from the last
+     * accessed node if that is closer still.
+     */
+    if (index < list->size / 2) {
+        curr = list->head;
+        i = 0;
+    } else {
+        curr = list->foot;
+        i = list->size - 1;
+    }
+    if (list->finger && (list->fingerindex > index
+        ? list->fingerindex - index : index - list->fingerindex)
+        < (i > index ? i - index : index - i)) {
+        curr = list->finger;
+        i = list->fingerindex;
+    }
+    LINKEDLIST_WALK(list, i > index ? i - index : index - i);
+
+    /* Iterate until index. */
+    while (i < index) {
+        curr = curr->next;
+        i++;
+    }
+    while (i > index) {
+        curr = curr->prev;
+        i--;
+    }
+
+    linkedlist_remember(list, curr, index);
+    return curr;
+}
+
+static void linkedlist_unlink(linkedlist_t *list, linkedlist_node_t *node) {
+    /* Remove node from list and free it. */
+    if (node->prev) {
+        node->prev->next = node->next;
+    } else {
+        list->head = node->next;
+    }
+    if (node->next) {
+        node->next->prev = node->prev;
+    } else {
+        list->foot = node->prev;
+    }
+    linkedlist_node_free(list, node);
+    list->size--;
+    linkedlist_forgetcheckpoints(list);
+}
+
+static int linkedlist_sharesnodes(linkedlist_t *a, linkedlist_t *b) {
+    /* Nodes can only move between lists which free them the same way. */
+    return !a->ownspool && !b->ownspool && a->pool == b->pool;
+}
+
+static linkedlist_node_t *linkedlist_copychain(linkedlist_t *dest,
+    linkedlist_node_t *srccurr, linkedlist_node_t **foot, size_t *size) {
+    linkedlist_node_t head, *destcurr = &head, *next;
 
-        /* Copy body nodes from src to dest. */
-        while (srccurr) {
-            destcurr = (linkedlist_node_t*)malloc(sizeof *destcurr);
-            if (!destcurr) {
-                fprintf(stderr, "Out of memory\n");
-                return 1;
+    /* Copy nodes from srccurr onwards into a chain of dest's nodes. */
+    head.next = NULL;
+    *size = 0;
+    while (srccurr) {
+        next = linkedlist_node_alloc(dest);
+        if (!next) {
+            /* Free the partial chain. */
+            for (destcurr = head.next; destcurr; destcurr = next) {
+                next = destcurr->next;
+                linkedlist_node_free(dest, destcurr);
             }
-            destcurr->next = NULL;
-            destcurr->data = srccurr->data;
+            return NULL;
+        }
+        next->next = NULL;
+        next->prev = destcurr == &head ? NULL : destcurr;
+        next->data = srccurr->data;
+        destcurr->next = next;
+        destcurr = next;
+        srccurr = srccurr->next;
+        (*size)++;
+    }
+    *foot = destcurr;
+    return head.next;
+}
+
+static void linkedlist_insertchain(linkedlist_t *list, linkedlist_node_t *prev,
+    linkedlist_node_t *head, linkedlist_node_t *foot, size_t size) {
+    /* Add chain to list after prev (or at the start if prev is null). */
+    linkedlist_node_t *next = prev ? prev->next : list->head;
+    head->prev = prev;
+    foot->next = next;
+    if (prev) {
+        prev->next = head;
+    } else {
+        list->head = head;
+    }
+    if (next) {
+        next->prev = foot;
+    } else {
+        list->foot = foot;
+    }
+    list->size += size;
+    linkedlist_forgetcheckpoints(list);
+}
+
+static void linkedlist_createlike(linkedlist_t *dest, linkedlist_t *src) {
+    /* Create a new empty list which allocates nodes and caches the same way
+     * as src.
+     */
+    if (src->ownspool || src->pool) {
+        linkedlist_createpooled(dest, src->ownspool ? NULL : src->pool);
+    } else {
+        linkedlist_create(dest);
+    }
+    dest->cache = src->cache;
+}
+
+int linkedlist_create(linkedlist_t *list) {
+    /* Initialise list attributes. */
+    linkedlist_reset(list);
+    list->pool = NULL;
+    list->ownspool = 0;
+    list->cache = 0;
+    list->checkpoints = NULL;
+    list->snapshot = NULL;
+    list->snapshotcapacity = 0;
+    LINKEDLIST_CLEAR(list);
+    LINKEDLIST_BEGIN(list, LINKEDLIST_OP_CREATE, 0);
+    return 0;
+}
 
-            destprev->next = destcurr;
+int linkedlist_createpooled(linkedlist_t *list, linkedlist_pool_t *pool) {
+    /* Initialise list attributes. Its own pool is created on first use. */
+    linkedlist_reset(list);
+    list->pool = pool;
+    list->ownspool = !pool;
+    list->cache = 0;
+    list->checkpoints = NULL;
+    list->snapshot = NULL;
+    list->snapshotcapacity = 0;
+    LINKEDLIST_CLEAR(list);
+    LINKEDLIST_BEGIN(list, LINKEDLIST_OP_CREATEPOOLED, 0);
+    return 0;
+}
+
+int linkedlist_destroy(linkedlist_t *list) {
+    linkedlist_node_t *curr = list->head, *next;
 
-            destprev = destcurr;
-            srccurr = srccurr->next;
+    LINKEDLIST_BEGIN(list, LINKEDLIST_OP_DESTROY, 0);
+    LINKEDLIST_FREE(list, list->size);
+    if (list->ownspool) {
+        /* Free the list's own pool, which frees all nodes a chunk at a time. */
+        if (list->pool) {
+            linkedlist_pool_destroy(list->pool);
+            free(list->pool);
+            list->pool = NULL;
+        }
+    } else if (list->pool) {
+        /* Return all nodes to the shared pool's free list at once. */
+        if (list->size > 0) {
+            list->foot->next = list->pool->free;
+            list->pool->free = list->head;
+        }
+    } else {
+        /* Free memory allocated for nodes in the list. */
+        while (curr) {
+            LINKEDLIST_WALK(list, 1);
+            next = curr->next;
+            free(curr);
+            curr = next;
         }
+    }
+
+    /* Empty the list. */
+    free(list->checkpoints);
+    list->checkpoints = NULL;
+    free(list->snapshot);
+    list->snapshot = NULL;
+    list->snapshotcapacity = 0;
+    linkedlist_reset(list);
+    return 0;
+}
+
+int linkedlist_clone(linkedlist_t *src, linkedlist_t *dest) {
+    linkedlist_node_t *srccurr, *destcurr, *destprev = NULL;
+
+    LINKEDLIST_BEGIN(src, LINKEDLIST_OP_CLONE, 0);
+
+    /* Create a new empty list for dest, allocating nodes the same way. */
+    linkedlist_createlike(dest, src);
+    if (src->size == 0) {
+        return 0;
+    }
+
+    /* Allocate every node at once, so that none are left over on failure. */
+    dest->head = linkedlist_node_allocchain(dest, src->size);
+    if (!dest->head) {
+        linkedlist_destroy(dest);
+        return 1;
+    }
 
-        /* Initialise dest attributes. */
-        dest->foot = destprev;
-        dest->size = src->size;
+    /* Copy items from src to dest. */
+    srccurr = src->head;
+    for (destcurr = dest->head; destcurr; destcurr = destcurr->next) {
+        destcurr->prev = destprev;
+        destcurr->data = srccurr->data;
+        destprev = destcurr;
+        srccurr = srccurr->next;
     }
 
+    /* Initialise dest attributes. */
+    dest->foot = destprev;
+    dest->size = src->size;
+    LINKEDLIST_WALK(src, src->size);
     return 0;
 }
 
 
 size_t linkedlist_size(linkedlist_t *list) {
+    LINKEDLIST_BEGIN(list, LINKEDLIST_OP_SIZE, 0);
     return list->size;
 }
 
 int linkedlist_isempty(linkedlist_t *list) {
+    LINKEDLIST_BEGIN(list, LINKEDLIST_OP_ISEMPTY, 0);
     return list->size == 0;
 }
 
 
 int linkedlist_push(linkedlist_t *list, void *data) {
-    linkedlist_node_t *node = (linkedlist_node_t*)malloc(sizeof *node);
+    linkedlist_node_t *node;
+
+    LINKEDLIST_BEGIN(list, LINKEDLIST_OP_PUSH, 0);
+    node = linkedlist_node_alloc(list);
     if (!node) {
-        fprintf(stderr, "Out of memory\n");
         return 1;
     }
 
     /* Initialise node attributes. */
     node->next = NULL;
+    node->prev = list->foot;
     node->data = data;
 
     /* Add node to list. */
@@ -107,12 +619,15 @@ int linkedlist_push(linkedlist_t *list, void *data) {
         list->foot = node;
         list->size++;
     }
+    linkedlist_forgetsnapshot(list);
     return 0;
 }
 
 void *linkedlist_pop(linkedlist_t *list) {
     void *data;
-    linkedlist_node_t *foot, *curr, *prev;
+    linkedlist_node_t *foot;
+
+    LINKEDLIST_BEGIN(list, LINKEDLIST_OP_POP, 0);
 
     /* Cannot pop empty list. */
     if (list->size == 0) {
@@ -123,35 +638,37 @@ void *linkedlist_pop(linkedlist_t *list) {
     /* Get item from list foot. */
     foot = list->foot;
     data = foot->data;
+    if (list->finger == foot) {
+        linkedlist_forget(list);
+    }
+    linkedlist_forgetcheckpoints(list);
 
     /* Remove node from list. */
     if (list->size == 1) {
-        free(foot);
-        linkedlist_create(list);
+        linkedlist_node_free(list, foot);
+        linkedlist_reset(list);
     } else {
         /* Assign new list foot. */
-        curr = list->head;
-        while (curr != foot) {
-            prev = curr;
-            curr = curr->next;
-        }
-        free(foot);
-        prev->next = NULL;
-        list->foot = prev;
+        list->foot = foot->prev;
+        list->foot->next = NULL;
+        linkedlist_node_free(list, foot);
         list->size--;
     }
     return data;
 }
 
 int linkedlist_unshift(linkedlist_t *list, void *data) {
-    linkedlist_node_t *node = (linkedlist_node_t*)malloc(sizeof *node);
+    linkedlist_node_t *node;
+
+    LINKEDLIST_BEGIN(list, LINKEDLIST_OP_UNSHIFT, 0);
+    node = linkedlist_node_alloc(list);
     if (!node) {
-        fprintf(stderr, "Out of memory\n");
         return 1;
     }
 
     /* Initialise node attributes. */
     node->next = list->head;
+    node->prev = NULL;
     node->data = data;
 
     /* Add node to list. */
@@ -159,8 +676,11 @@ int linkedlist_unshift(linkedlist_t *list, void *data) {
         list->head = list->foot = node;
         list->size = 1;
     } else {
+        list->head->prev = node;
         list->head = node;
         list->size++;
+        list->fingerindex++;
+        linkedlist_forgetcheckpoints(list);
     }
     return 0;
 }
@@ -169,6 +689,8 @@ void *linkedlist_shift(linkedlist_t *list) {
     void *data;
     linkedlist_node_t *head;
 
+    LINKEDLIST_BEGIN(list, LINKEDLIST_OP_SHIFT, 0);
+
     /* Cannot shift empty list. */
     if (list->size == 0) {
         fprintf(stderr, "List is empty\n");
@@ -178,22 +700,139 @@ void *linkedlist_shift(linkedlist_t *list) {
     /* Get item from list head. */
     head = list->head;
     data = head->data;
+    if (list->finger == head) {
+        linkedlist_forget(list);
+    }
+    list->fingerindex--;
+    linkedlist_forgetcheckpoints(list);
 
     /* Remove node from list. */
     if (list->size == 1) {
-        free(head);
-        linkedlist_create(list);
+        linkedlist_node_free(list, head);
+        linkedlist_reset(list);
     } else {
         /* Assign new list head. */
         list->head = head->next;
-        free(head);
+        list->head->prev = NULL;
+        linkedlist_node_free(list, head);
         list->size--;
     }
     return data;
 }
 
+int linkedlist_pushn(linkedlist_t *list, void *src[], size_t count) {
+    linkedlist_node_t *head, *curr, *prev = list->foot;
+    size_t i = 0;
+
+    LINKEDLIST_BEGIN(list, LINKEDLIST_OP_PUSHN, count);
+    if (count == 0) {
+        return 0;
+    }
+    head = linkedlist_node_allocchain(list, count);
+    if (!head) {
+        return 1;
+    }
+
+    /* Initialise node attributes. */
+    for (curr = head; curr; curr = curr->next) {
+        curr->prev = prev;
+        curr->data = src[i++];
+        prev = curr;
+    }
+
+    /* Add nodes to list. */
+    if (list->size == 0) {
+        list->head = head;
+    } else {
+        list->foot->next = head;
+    }
+    list->foot = prev;
+    list->size += count;
+    linkedlist_forgetsnapshot(list);
+    return 0;
+}
+
+size_t linkedlist_popn(linkedlist_t *list, void *dest[], size_t count) {
+    linkedlist_node_t *foot = list->foot, *curr = foot;
+    size_t i;
+
+    LINKEDLIST_BEGIN(list, LINKEDLIST_OP_POPN, count);
+    if (count > list->size) {
+        count = list->size;
+    }
+    if (count == 0) {
+        return 0;
+    }
+    LINKEDLIST_WALK(list, count);
+
+    /* Get items from list foot. */
+    dest[0] = curr->data;
+    for (i = 1; i < count; i++) {
+        curr = curr->prev;
+        dest[i] = curr->data;
+    }
+    if (list->finger && list->fingerindex >= list->size - count) {
+        linkedlist_forget(list);
+    }
+    linkedlist_forgetcheckpoints(list);
+
+    /* Remove nodes from list. */
+    if (count == list->size) {
+        linkedlist_node_freechain(list, curr, foot, count);
+        linkedlist_reset(list);
+    } else {
+        /* Assign new list foot. */
+        list->foot = curr->prev;
+        list->foot->next = NULL;
+        linkedlist_node_freechain(list, curr, foot, count);
+        list->size -= count;
+    }
+    return count;
+}
+
+size_t linkedlist_shiftn(linkedlist_t *list, void *dest[], size_t count) {
+    linkedlist_node_t *head = list->head, *curr = head;
+    size_t i;
+
+    LINKEDLIST_BEGIN(list, LINKEDLIST_OP_SHIFTN, count);
+    if (count > list->size) {
+        count = list->size;
+    }
+    if (count == 0) {
+        return 0;
+    }
+    LINKEDLIST_WALK(list, count);
+
+    /* Get items from list head. */
+    dest[0] = curr->data;
+    for (i = 1; i < count; i++) {
+        curr = curr->next;
+        dest[i] = curr->data;
+    }
+    if (list->fingerindex < count) {
+        linkedlist_forget(list);
+    }
+    list->fingerindex -= count;
+    linkedlist_forgetcheckpoints(list);
+
+    /* Remove nodes from list. */
+    if (count == list->size) {
+        linkedlist_node_freechain(list, head, curr, count);
+        linkedlist_reset(list);
+    } else {
+        /* Assign new list head. */
+        list->head = curr->next;
+        list->head->prev = NULL;
+        linkedlist_node_freechain(list, head, curr, count);
+        list->size -= count;
+    }
+    return count;
+}
+
 int linkedlist_add(linkedlist_t *list, size_t index, void *data) {
-    linkedlist_node_t *node, *curr, *prev;
+    linkedlist_node_t *node, *curr;
+
+    LINKEDLIST_BEGIN(list, LINKEDLIST_OP_ADD, index);
 
     /* Cannot add to index beyond list size. */
     if (index > list->size) {
@@ -208,33 +847,36 @@ int linkedlist_add(linkedlist_t *list, size_t index, void *data) {
         return linkedlist_push(list, data);
     } else {
         /* Iterate until index. */
-        curr = list->head;
-        while (index-- > 0) {
-            prev = curr;
-            curr = curr->next;
-        }
+        curr = linkedlist_node_at(list, index);
 
         /* Create new node. */
-        node = (linkedlist_node_t*)malloc(sizeof *node);
+        node = linkedlist_node_alloc(list);
         if (!node) {
-            fprintf(stderr, "Out of memory\n");
             return 1;
         }
 
         /* Initialise node attributes. */
         node->next = curr;
+        node->prev = curr->prev;
         node->data = data;
 
         /* Add node to list. */
-        prev->next = node;
+        curr->prev->next = node;
+        curr->prev = node;
         list->size++;
+        linkedlist_forgetcheckpoints(list);
+
+        /* Remember node in place of the node after it. */
+        linkedlist_remember(list, node, index);
         return 0;
     }
 }
 
 void *linkedlist_remove(linkedlist_t *list, size_t index) {
     void *data;
-    linkedlist_node_t *curr, *prev;
+    linkedlist_node_t *curr;
+
+    LINKEDLIST_BEGIN(list, LINKEDLIST_OP_REMOVE, index);
 
     /* Cannot remove from empty list. */
     if (list->size == 0) {
@@ -254,19 +896,18 @@ void *linkedlist_remove(linkedlist_t *list, size_t index) {
         return linkedlist_pop(list);
     } else {
         /* Iterate until index. */
-        curr = list->head;
-        while (index-- > 0) {
-            prev = curr;
-            curr = curr->next;
-        }
+        curr = linkedlist_node_at(list, index);
 
         /* Get item. */
         data = curr->data;
 
         /* Remove node from list. */
-        prev->next = curr->next;
-        free(curr);
+        curr->prev->next = curr->next;
+        curr->next->prev = curr->prev;
+        linkedlist_remember(list, curr->next, index);
+        linkedlist_node_free(list, curr);
         list->size--;
+        linkedlist_forgetcheckpoints(list);
 
         return data;
     }
@@ -275,6 +916,8 @@ void *linkedlist_remove(linkedlist_t *list, size_t index) {
 int linkedlist_set(linkedlist_t *list, size_t index, void *data) {
     linkedlist_node_t *curr;
 
+    LINKEDLIST_BEGIN(list, LINKEDLIST_OP_SET, index);
+
     /* Cannot set in empty list. */
     if (list->size == 0) {
         fprintf(stderr, "List is empty\n");
@@ -288,11 +931,9 @@ int linkedlist_set(linkedlist_t *list, size_t index, void *data) {
     }
 
     /* Iterate until index. */
-    curr = list->head;
-    while (index-- > 0) {
-        curr = curr->next;
-    }
+    curr = linkedlist_node_at(list, index);
     curr->data = data;
+    linkedlist_forgetsnapshot(list);
     return 0;
 }
 
@@ -300,6 +941,8 @@ int linkedlist_addarray(linkedlist_t *dest, void *src[]) {
     void *data;
     size_t i = 0;
 
+    LINKEDLIST_BEGIN(dest, LINKEDLIST_OP_ADDARRAY, 0);
+
     /* Add nodes from src to dest. */
     while ((data = src[i++])) {
         if (linkedlist_push(dest, data) != 0) {
@@ -309,52 +952,210 @@ int linkedlist_addarray(linkedlist_t *dest, void *src[]) {
     return 0;
 }
 
-int linkedlist_removearray(linkedlist_t *dest, void *src[]) {
+typedef struct linkedlist_tally_t {
     void *data;
-    size_t i = 0, dataindex;
+    size_t count;
+    int used;
+} linkedlist_tally_t;
 
-    /* Remove nodes from src to dest. */
-    while (dest->size > 0 && (data = src[i++])) {
-        dataindex = linkedlist_indexof(dest, data);
-        if (dataindex < dest->size) {
-            linkedlist_remove(dest, dataindex);
-        }
+static linkedlist_tally_t *linkedlist_tally_create(size_t count, size_t *mask) {
+    linkedlist_tally_t *table;
+    size_t size = 8;
+
+    /* Size the hash table to at most half full. */
+    while (size < count * 2) {
+        size <<= 1;
     }
-    return 0;
+    table = (linkedlist_tally_t*)calloc(size, sizeof *table);
+    if (!table) {
+        fprintf(stderr, "Out of memory\n");
+        return NULL;
+    }
+    *mask = size - 1;
+    return table;
 }
 
-int linkedlist_addlinkedlist(linkedlist_t *dest, linkedlist_t *src) {
-    linkedlist_node_t *srccurr = src->head;
-
-    /* Add nodes from src to dest. */
-    while (srccurr) {
-        if (linkedlist_push(dest, srccurr->data) != 0) {
-            return 1;
-        }
-        srccurr = srccurr->next;
+static linkedlist_tally_t *linkedlist_tally_find(linkedlist_tally_t *table,
+    size_t mask, void *data) {
+    /* Hash the pointer and probe linearly until its entry or an empty one. */
+    size_t i = (size_t)(((uint64_t)(uintptr_t)data * 0x9E3779B97F4A7C15ULL)
+        >> 32) & mask;
+    while (table[i].used && table[i].data != data) {
+        i = (i + 1) & mask;
     }
-    return 0;
+    return &table[i];
 }
 
-int linkedlist_removelinkedlist(linkedlist_t *dest, linkedlist_t *src) {
-    linkedlist_node_t *srccurr = src->head;
-    size_t dataindex;
+static void linkedlist_tally_add(linkedlist_tally_t *table, size_t mask,
+    void *data) {
+    linkedlist_tally_t *entry = linkedlist_tally_find(table, mask, data);
+    entry->data = data;
+    entry->count++;
+    entry->used = 1;
+}
 
-    /* Remove nodes from src to dest. */
-    while (srccurr) {
-        dataindex = linkedlist_indexof(dest, srccurr->data);
-        if (dataindex < dest->size) {
-            linkedlist_remove(dest, dataindex);
-        }
+static void linkedlist_removetallied(linkedlist_t *list,
+    linkedlist_tally_t *table, size_t mask, size_t count, int all) {
+    linkedlist_node_t *curr = list->head, *next;
+    linkedlist_tally_t *entry;
+
+    /* Remove tallied items, only as many times as tallied unless all. */
+    linkedlist_forget(list);
+    while (curr && (all || count > 0)) {
+        LINKEDLIST_WALK(list, 1);
+        next = curr->next;
+        entry = linkedlist_tally_find(table, mask, curr->data);
+        if (entry->used && entry->count > 0) {
+            if (!all) {
+                entry->count--;
+                count--;
+            }
+            linkedlist_unlink(list, curr);
+        }
+        curr = next;
+    }
+}
+
+static int linkedlist_removearraytallied(linkedlist_t *dest, void *src[],
+    int all) {
+    linkedlist_tally_t *table;
+    size_t i, count, mask;
+
+    /* Count items in src. */
+    for (count = 0; src[count]; count++) {
+    }
+    if (dest->size == 0 || count == 0) {
+        return 0;
+    }
+
+    /* Tally items from src, then remove them from dest in one pass. */
+    table = linkedlist_tally_create(count, &mask);
+    if (!table) {
+        return 1;
+    }
+    for (i = 0; i < count; i++) {
+        linkedlist_tally_add(table, mask, src[i]);
+    }
+    linkedlist_removetallied(dest, table, mask, count, all);
+    free(table);
+    return 0;
+}
+
+static int linkedlist_removelinkedlisttallied(linkedlist_t *dest,
+    linkedlist_t *src, int all) {
+    linkedlist_tally_t *table;
+    linkedlist_node_t *srccurr;
+    size_t mask;
+
+    if (dest->size == 0 || src->size == 0) {
+        return 0;
+    }
+
+    /* Tally items from src, then remove them from dest in one pass. */
+    table = linkedlist_tally_create(src->size, &mask);
+    if (!table) {
+        return 1;
+    }
+    for (srccurr = src->head; srccurr; srccurr = srccurr->next) {
+        linkedlist_tally_add(table, mask, srccurr->data);
+    }
+    linkedlist_removetallied(dest, table, mask, src->size, all);
+    free(table);
+    return 0;
+}
+
+int linkedlist_removearray(linkedlist_t *dest, void *src[]) {
+    LINKEDLIST_BEGIN(dest, LINKEDLIST_OP_REMOVEARRAY, 0);
+    return linkedlist_removearraytallied(dest, src, 0);
+}
+
+int linkedlist_removearrayall(linkedlist_t *dest, void *src[]) {
+    LINKEDLIST_BEGIN(dest, LINKEDLIST_OP_REMOVEARRAYALL, 0);
+    return linkedlist_removearraytallied(dest, src, 1);
+}
+
+int linkedlist_addlinkedlist(linkedlist_t *dest, linkedlist_t *src) {
+    linkedlist_node_t *srccurr = src->head;
+
+    LINKEDLIST_BEGIN(dest, LINKEDLIST_OP_ADDLINKEDLIST, 0);
+
+    /* Add nodes from src to dest. */
+    while (srccurr) {
+        if (linkedlist_push(dest, srccurr->data) != 0) {
+            return 1;
+        }
         srccurr = srccurr->next;
     }
     return 0;
 }
 
+int linkedlist_removelinkedlist(linkedlist_t *dest, linkedlist_t *src) {
+    LINKEDLIST_BEGIN(dest, LINKEDLIST_OP_REMOVELINKEDLIST, 0);
+    return linkedlist_removelinkedlisttallied(dest, src, 0);
+}
+
+int linkedlist_removelinkedlistall(linkedlist_t *dest, linkedlist_t *src) {
+    LINKEDLIST_BEGIN(dest, LINKEDLIST_OP_REMOVELINKEDLISTALL, 0);
+    return linkedlist_removelinkedlisttallied(dest, src, 1);
+}
+
+int linkedlist_concat(linkedlist_t *dest, linkedlist_t *src) {
+    LINKEDLIST_BEGIN(dest, LINKEDLIST_OP_CONCAT, 0);
+    return linkedlist_splice(dest, dest->size, src);
+}
+
+int linkedlist_splice(linkedlist_t *dest, size_t index, linkedlist_t *src) {
+    linkedlist_node_t *prev, *head, *foot;
+    size_t size;
+
+    LINKEDLIST_BEGIN(dest, LINKEDLIST_OP_SPLICE, index);
+
+    /* Cannot add to index beyond list size. */
+    if (index > dest->size) {
+        fprintf(stderr, "List out of range\n");
+        return 1;
+    }
+
+    /* Cannot splice a list into itself. */
+    if (src == dest) {
+        fprintf(stderr, "List cannot be spliced into itself\n");
+        return 1;
+    }
+
+    if (src->size == 0) {
+        return 0;
+    }
+
+    /* Take over nodes from src, or copy them if src frees them differently. */
+    if (linkedlist_sharesnodes(dest, src)) {
+        head = src->head;
+        foot = src->foot;
+        size = src->size;
+        linkedlist_reset(src);
+    } else {
+        head = linkedlist_copychain(dest, src->head, &foot, &size);
+        if (!head) {
+            return 1;
+        }
+        LINKEDLIST_WALK(dest, size);
+        linkedlist_destroy(src);
+    }
+
+    /* Add nodes to dest. */
+    prev = index == 0 ? NULL : linkedlist_node_at(dest, index - 1);
+    if (!prev) {
+        dest->fingerindex += size;
+    }
+    linkedlist_insertchain(dest, prev, head, foot, size);
+    return 0;
+}
+
 
 void *linkedlist_get(linkedlist_t *list, size_t index) {
     linkedlist_node_t *curr;
 
+    LINKEDLIST_BEGIN(list, LINKEDLIST_OP_GET, index);
+
     /* Cannot get from empty list. */
     if (list->size == 0) {
         fprintf(stderr, "List is empty\n");
@@ -368,14 +1169,13 @@ void *linkedlist_get(linkedlist_t *list, size_t index) {
     }
 
     /* Iterate until index. */
-    curr = list->head;
-    while (index-- > 0) {
-        curr = curr->next;
-    }
+    curr = linkedlist_node_at(list, index);
     return curr->data;
 }
 
 void *linkedlist_first(linkedlist_t *list) {
+    LINKEDLIST_BEGIN(list, LINKEDLIST_OP_FIRST, 0);
+
     /* Cannot get from empty list. */
     if (list->size == 0) {
         fprintf(stderr, "List is empty\n");
@@ -386,6 +1186,8 @@ void *linkedlist_first(linkedlist_t *list) {
 }
 
 void *linkedlist_last(linkedlist_t *list) {
+    LINKEDLIST_BEGIN(list, LINKEDLIST_OP_LAST, 0);
+
     /* Cannot get from empty list. */
     if (list->size == 0) {
         fprintf(stderr, "List is empty\n");
@@ -395,14 +1197,148 @@ void *linkedlist_last(linkedlist_t *list) {
     return list->foot->data;
 }
 
-size_t linkedlist_indexof(linkedlist_t *list, void *data) {
+static size_t linkedlist_search_scalar(void **items, size_t size,
+    void **keys, size_t count) {
+    size_t i, j;
+
+    /* Compare each item with each key. */
+    for (i = 0; i < size; i++) {
+        for (j = 0; j < count; j++) {
+            if (items[i] == keys[j]) {
+                return i;
+            }
+        }
+    }
+    return size;
+}
+
+#ifdef LINKEDLIST_SIMD
+__attribute__((target("sse2")))
+static size_t linkedlist_search_sse2(void **items, size_t size, void **keys,
+    size_t count) {
+    __m128i vkeys[SEARCHKEYS], a, b, match, equal;
+    size_t i, j;
+
+    for (j = 0; j < count; j++) {
+        vkeys[j] = _mm_set1_epi64x((long long)(intptr_t)keys[j]);
+    }
+
+    /* Compare 4 items at a time, then find which matched. SSE2 compares 32 bits
+     * at a time, so both halves of a pointer must match.
+     */
+    for (i = 0; i + 4 <= size; i += 4) {
+        a = _mm_loadu_si128((const __m128i*)(items + i));
+        b = _mm_loadu_si128((const __m128i*)(items + i + 2));
+        match = _mm_setzero_si128();
+        for (j = 0; j < count; j++) {
+            equal = _mm_cmpeq_epi32(a, vkeys[j]);
+            match = _mm_or_si128(match, _mm_and_si128(equal,
+                _mm_shuffle_epi32(equal, _MM_SHUFFLE(2, 3, 0, 1))));
+            equal = _mm_cmpeq_epi32(b, vkeys[j]);
+            match = _mm_or_si128(match, _mm_and_si128(equal,
+                _mm_shuffle_epi32(equal, _MM_SHUFFLE(2, 3, 0, 1))));
+        }
+        if (_mm_movemask_epi8(match)) {
+            break;
+        }
+    }
+    return i + linkedlist_search_scalar(items + i, size - i, keys, count);
+}
+
+__attribute__((target("avx2")))
+static size_t linkedlist_search_avx2(void **items, size_t size, void **keys,
+    size_t count) {
+    __m256i vkeys[SEARCHKEYS], a, b, match;
+    size_t i, j;
+
+    for (j = 0; j < count; j++) {
+        vkeys[j] = _mm256_set1_epi64x((long long)(intptr_t)keys[j]);
+    }
+
+    /* Compare 8 items at a time, then find which matched. */
+    for (i = 0; i + 8 <= size; i += 8) {
+        a = _mm256_loadu_si256((const __m256i*)(items + i));
+        b = _mm256_loadu_si256((const __m256i*)(items + i + 4));
+        match = _mm256_setzero_si256();
+        for (j = 0; j < count; j++) {
+            match = _mm256_or_si256(match, _mm256_or_si256(
+                _mm256_cmpeq_epi64(a, vkeys[j]),
+                _mm256_cmpeq_epi64(b, vkeys[j])));
+        }
+        if (!_mm256_testz_si256(match, match)) {
+            break;
+        }
+    }
+    return i + linkedlist_search_scalar(items + i, size - i, keys, count);
+}
+#endif
+
+static size_t linkedlist_search(void **items, size_t size, void **keys,
+    size_t count) {
+    /* Use the widest instructions the processor supports. */
+#ifdef LINKEDLIST_SIMD
+    if (__builtin_cpu_supports("avx2")) {
+        return linkedlist_search_avx2(items, size, keys, count);
+    }
+    if (__builtin_cpu_supports("sse2")) {
+        return linkedlist_search_sse2(items, size, keys, count);
+    }
+#endif
+    return linkedlist_search_scalar(items, size, keys, count);
+}
+
+static int linkedlist_snapshot(linkedlist_t *list) {
+    /* The packed items are up to date once searches have walked enough. */
+    return LINKEDLIST_SNAPSHOT_WALKS > 0 && list->size > 0
+        && list->searches >= list->size * LINKEDLIST_SNAPSHOT_WALKS;
+}
+
+static void linkedlist_searched(linkedlist_t *list, size_t walked) {
+    linkedlist_node_t *curr;
+    void **snapshot;
+    size_t i = 0;
+
+    /* Count the items walked, and pack the items once the count is reached. */
+    if (LINKEDLIST_SNAPSHOT_WALKS == 0 || !list->cache
+        || linkedlist_snapshot(list)) {
+        return;
+    }
+    list->searches += walked;
+    if (!linkedlist_snapshot(list)) {
+        return;
+    }
+
+    /* Grow array if needed, or keep walking the list if out of memory. */
+    if (list->snapshotcapacity < list->size) {
+        snapshot = (void**)realloc(list->snapshot,
+            list->size * sizeof *snapshot);
+        if (!snapshot) {
+            list->searches = 0;
+            return;
+        }
+        list->snapshot = snapshot;
+        list->snapshotcapacity = list->size;
+    }
+
+    /* Copy items into array. */
+    for (curr = list->head; curr; curr = curr->next) {
+        list->snapshot[i++] = curr->data;
+    }
+    LINKEDLIST_WALK(list, list->size);
+}
+
+static size_t linkedlist_walkkeys(linkedlist_t *list, void **keys,
+    size_t count) {
     linkedlist_node_t *curr = list->head;
-    size_t index = 0;
+    size_t index = 0, j;
 
     /* Test each item until an item passes the test. */
     while (curr) {
-        if (curr->data == data) {
-            break;
+        LINKEDLIST_WALK(list, 1);
+        for (j = 0; j < count; j++) {
+            if (curr->data == keys[j]) {
+                return index;
+            }
         }
         curr = curr->next;
         index++;
@@ -410,11 +1346,119 @@ size_t linkedlist_indexof(linkedlist_t *list, void *data) {
     return index;
 }
 
+static size_t linkedlist_indexofkeys(linkedlist_t *list, void **keys,
+    size_t count) {
+    size_t index;
+
+    /* Search the packed items if the list has not changed. */
+    if (linkedlist_snapshot(list)) {
+        return linkedlist_search(list->snapshot, list->size, keys, count);
+    }
+
+    index = linkedlist_walkkeys(list, keys, count);
+    linkedlist_searched(list, index < list->size ? index + 1 : index);
+    return index;
+}
+
+static size_t linkedlist_indexoftallied(linkedlist_t *list, void **keys,
+    size_t count) {
+    linkedlist_tally_t *table;
+    linkedlist_node_t *curr;
+    size_t mask, index = 0, i;
+
+    /* Tally keys to look up each item in constant time, or compare each item
+     * with each key if out of memory.
+     */
+    table = linkedlist_tally_create(count, &mask);
+    if (!table) {
+        return linkedlist_walkkeys(list, keys, count);
+    }
+    for (i = 0; i < count; i++) {
+        linkedlist_tally_add(table, mask, keys[i]);
+    }
+
+    /* Test each item until an item passes the test. */
+    if (linkedlist_snapshot(list)) {
+        while (index < list->size && !linkedlist_tally_find(table, mask,
+            list->snapshot[index])->used) {
+            index++;
+        }
+    } else {
+        for (curr = list->head; curr && !linkedlist_tally_find(table, mask,
+            curr->data)->used; curr = curr->next) {
+            LINKEDLIST_WALK(list, 1);
+            index++;
+        }
+        linkedlist_searched(list, curr ? index + 1 : index);
+    }
+    free(table);
+    return index;
+}
+
+size_t linkedlist_indexof(linkedlist_t *list, void *data) {
+    LINKEDLIST_BEGIN(list, LINKEDLIST_OP_INDEXOF, 0);
+    return linkedlist_indexofkeys(list, &data, 1);
+}
+
+size_t linkedlist_indexofany(linkedlist_t *list, void *data[]) {
+    size_t count = 0;
+
+    LINKEDLIST_BEGIN(list, LINKEDLIST_OP_INDEXOFANY, 0);
+    while (data[count]) {
+        count++;
+    }
+    if (count > SEARCHKEYS) {
+        return linkedlist_indexoftallied(list, data, count);
+    }
+    return linkedlist_indexofkeys(list, data, count);
+}
+
+static linkedlist_node_t *linkedlist_prefetchstart(linkedlist_node_t *node,
+    int reverse) {
+#ifdef LINKEDLIST_PREFETCHING
+    size_t i;
+
+    /* Get the node the prefetch distance past node, fetching those between. */
+    for (i = 0; i < LINKEDLIST_PREFETCH && node; i++) {
+        node = reverse ? node->prev : node->next;
+    }
+    return node;
+#else
+    (void)node;
+    (void)reverse;
+    return NULL;
+#endif
+}
+
+static linkedlist_node_t *linkedlist_prefetchnext(linkedlist_node_t *ahead,
+    int reverse) {
+#ifdef LINKEDLIST_PREFETCHING
+    /* Prefetch the item of the node ahead, which was prefetched on the last
+     * step, then move ahead on and prefetch the next node.
+     */
+    if (ahead) {
+        __builtin_prefetch(ahead->data);
+        ahead = reverse ? ahead->prev : ahead->next;
+        if (ahead) {
+            __builtin_prefetch(ahead);
+        }
+    }
+#else
+    (void)reverse;
+#endif
+    return ahead;
+}
+
 void *linkedlist_find(linkedlist_t *list, int (*f)(void *)) {
     linkedlist_node_t *curr = list->head;
+    linkedlist_node_t *ahead = linkedlist_prefetchstart(curr, 0);
+
+    LINKEDLIST_BEGIN(list, LINKEDLIST_OP_FIND, 0);
 
     /* Test each item until an item passes the test. */
     while (curr) {
+        LINKEDLIST_WALK(list, 1);
+        ahead = linkedlist_prefetchnext(ahead, 0);
         if (f(curr->data) == 1) {
             return curr->data;
         }
@@ -425,10 +1469,15 @@ void *linkedlist_find(linkedlist_t *list, int (*f)(void *)) {
 
 size_t linkedlist_findindex(linkedlist_t *list, int (*f)(void *)) {
     linkedlist_node_t *curr = list->head;
+    linkedlist_node_t *ahead = linkedlist_prefetchstart(curr, 0);
     size_t index = 0;
 
+    LINKEDLIST_BEGIN(list, LINKEDLIST_OP_FINDINDEX, 0);
+
     /* Test each item until an item passes the test. */
     while (curr) {
+        LINKEDLIST_WALK(list, 1);
+        ahead = linkedlist_prefetchnext(ahead, 0);
         if (f(curr->data) == 1) {
             break;
         }
@@ -440,20 +1489,308 @@ size_t linkedlist_findindex(linkedlist_t *list, int (*f)(void *)) {
 
 int linkedlist_foreach(linkedlist_t *list, void (*f)(void *)) {
     linkedlist_node_t *curr = list->head;
+    linkedlist_node_t *ahead = linkedlist_prefetchstart(curr, 0);
+
+    LINKEDLIST_BEGIN(list, LINKEDLIST_OP_FOREACH, 0);
 
     /* Execute function on every item. */
     while (curr) {
+        LINKEDLIST_WALK(list, 1);
+        ahead = linkedlist_prefetchnext(ahead, 0);
         f(curr->data);
         curr = curr->next;
     }
     return 0;
 }
 
+int linkedlist_foreachreverse(linkedlist_t *list, void (*f)(void *)) {
+    linkedlist_node_t *curr = list->foot;
+    linkedlist_node_t *ahead = linkedlist_prefetchstart(curr, 1);
+
+    LINKEDLIST_BEGIN(list, LINKEDLIST_OP_FOREACHREVERSE, 0);
+
+    /* Execute function on every item from the end of the list. */
+    while (curr) {
+        LINKEDLIST_WALK(list, 1);
+        ahead = linkedlist_prefetchnext(ahead, 1);
+        f(curr->data);
+        curr = curr->prev;
+    }
+    return 0;
+}
+
+
+
+int linkedlist_cursor_begin(linkedlist_t *list, linkedlist_cursor_t *cursor) {
+    LINKEDLIST_BEGIN(list, LINKEDLIST_OP_CURSOR_BEGIN, 0);
+
+    /* Initialise cursor attributes. */
+    cursor->list = list;
+    cursor->node = list->head;
+    cursor->index = list->head ? 0 : list->size;
+    return 0;
+}
+
+int linkedlist_cursor_beginreverse(linkedlist_t *list,
+    linkedlist_cursor_t *cursor) {
+    LINKEDLIST_BEGIN(list, LINKEDLIST_OP_CURSOR_BEGINREVERSE, 0);
+
+    /* Initialise cursor attributes. */
+    cursor->list = list;
+    cursor->node = list->foot;
+    cursor->index = list->foot ? list->size - 1 : list->size;
+    return 0;
+}
+
+int linkedlist_cursor_isend(linkedlist_cursor_t *cursor) {
+    LINKEDLIST_BEGIN(cursor->list, LINKEDLIST_OP_CURSOR_ISEND, cursor->index);
+    return !cursor->node;
+}
+
+int linkedlist_cursor_next(linkedlist_cursor_t *cursor) {
+    LINKEDLIST_BEGIN(cursor->list, LINKEDLIST_OP_CURSOR_NEXT, cursor->index);
+
+    /* Cannot move past the end of the list. */
+    if (!cursor->node) {
+        fprintf(stderr, "List out of range\n");
+        return 1;
+    }
+
+    LINKEDLIST_WALK(cursor->list, 1);
+    cursor->node = cursor->node->next;
+    cursor->index = cursor->node ? cursor->index + 1 : cursor->list->size;
+    return 0;
+}
+
+int linkedlist_cursor_prev(linkedlist_cursor_t *cursor) {
+    LINKEDLIST_BEGIN(cursor->list, LINKEDLIST_OP_CURSOR_PREV, cursor->index);
+
+    /* Cannot move past the end of the list. */
+    if (!cursor->node) {
+        fprintf(stderr, "List out of range\n");
+        return 1;
+    }
+
+    LINKEDLIST_WALK(cursor->list, 1);
+    cursor->node = cursor->node->prev;
+    cursor->index = cursor->node ? cursor->index - 1 : cursor->list->size;
+    return 0;
+}
+
+size_t linkedlist_cursor_index(linkedlist_cursor_t *cursor) {
+    LINKEDLIST_BEGIN(cursor->list, LINKEDLIST_OP_CURSOR_INDEX, cursor->index);
+    return cursor->index;
+}
+
+void *linkedlist_cursor_get(linkedlist_cursor_t *cursor) {
+    LINKEDLIST_BEGIN(cursor->list, LINKEDLIST_OP_CURSOR_GET, cursor->index);
+
+    /* Cannot get past the end of the list. */
+    if (!cursor->node) {
+        fprintf(stderr, "List out of range\n");
+        return NULL;
+    }
+
+    return cursor->node->data;
+}
+
+int linkedlist_cursor_set(linkedlist_cursor_t *cursor, void *data) {
+    LINKEDLIST_BEGIN(cursor->list, LINKEDLIST_OP_CURSOR_SET, cursor->index);
+
+    /* Cannot set past the end of the list. */
+    if (!cursor->node) {
+        fprintf(stderr, "List out of range\n");
+        return 1;
+    }
+
+    cursor->node->data = data;
+    linkedlist_forgetsnapshot(cursor->list);
+    return 0;
+}
+
+int linkedlist_cursor_insertafter(linkedlist_cursor_t *cursor, void *data) {
+    linkedlist_t *list = cursor->list;
+    linkedlist_node_t *node, *curr = cursor->node;
+
+    LINKEDLIST_BEGIN(list, LINKEDLIST_OP_CURSOR_INSERTAFTER, cursor->index);
+
+    /* Cannot add past the end of the list. */
+    if (!curr) {
+        fprintf(stderr, "List out of range\n");
+        return 1;
+    }
+
+    if (curr == list->foot) {
+        return linkedlist_push(list, data);
+    }
+
+    /* Create new node. */
+    node = linkedlist_node_alloc(list);
+    if (!node) {
+        return 1;
+    }
+
+    /* Initialise node attributes. */
+    node->next = curr->next;
+    node->prev = curr;
+    node->data = data;
+
+    /* Add node to list. */
+    curr->next->prev = node;
+    curr->next = node;
+    list->size++;
+    linkedlist_forgetcheckpoints(list);
+
+    /* Remember node in place of the node after it. */
+    linkedlist_remember(list, node, cursor->index + 1);
+    return 0;
+}
+
+void *linkedlist_cursor_remove(linkedlist_cursor_t *cursor) {
+    void *data;
+    linkedlist_t *list = cursor->list;
+    linkedlist_node_t *curr = cursor->node;
+
+    LINKEDLIST_BEGIN(list, LINKEDLIST_OP_CURSOR_REMOVE, cursor->index);
+
+    /* Cannot remove past the end of the list. */
+    if (!curr) {
+        fprintf(stderr, "List out of range\n");
+        return NULL;
+    }
+
+    /* Remove node from list and move to the next node. */
+    data = curr->data;
+    cursor->node = curr->next;
+    linkedlist_unlink(list, curr);
+    if (cursor->node) {
+        linkedlist_remember(list, cursor->node, cursor->index);
+    } else {
+        linkedlist_forget(list);
+        cursor->index = list->size;
+    }
+    return data;
+}
+
+
+int linkedlist_view_create(linkedlist_t *list, size_t start, size_t end,
+    linkedlist_view_t *view) {
+    LINKEDLIST_BEGIN(list, LINKEDLIST_OP_VIEW_CREATE, start);
+
+    /* View to end of list, or view nothing. */
+    if (end > list->size) {
+        end = list->size;
+    }
+    view->list = list;
+    if (start >= end) {
+        view->head = NULL;
+        view->index = list->size;
+        view->size = 0;
+        return 0;
+    }
+
+    /* Find the view head, from the last accessed node if that is closest. */
+    view->head = linkedlist_node_at(list, start);
+    view->index = start;
+    view->size = end - start;
+    return 0;
+}
+
+int linkedlist_view_fromcursor(linkedlist_cursor_t *cursor, size_t count,
+    linkedlist_view_t *view) {
+    linkedlist_t *list = cursor->list;
+
+    LINKEDLIST_BEGIN(list, LINKEDLIST_OP_VIEW_FROMCURSOR, cursor->index);
+
+    /* Initialise view attributes, viewing to end of list at most. */
+    view->list = list;
+    view->head = cursor->node;
+    view->index = cursor->index;
+    view->size = !cursor->node ? 0
+        : count < list->size - cursor->index ? count
+        : list->size - cursor->index;
+    return 0;
+}
+
+size_t linkedlist_view_size(linkedlist_view_t *view) {
+    LINKEDLIST_BEGIN(view->list, LINKEDLIST_OP_VIEW_SIZE, view->index);
+    return view->size;
+}
+
+size_t linkedlist_view_indexof(linkedlist_view_t *view, void *data) {
+    linkedlist_node_t *curr = view->head;
+    size_t index = 0;
+
+    LINKEDLIST_BEGIN(view->list, LINKEDLIST_OP_VIEW_INDEXOF, view->index);
+
+    /* Iterate until item is found or the end of the view. */
+    while (index < view->size && curr->data != data) {
+        curr = curr->next;
+        index++;
+    }
+    LINKEDLIST_WALK(view->list, index);
+    return index;
+}
+
+void *linkedlist_view_find(linkedlist_view_t *view, int (*f)(void *)) {
+    linkedlist_node_t *curr = view->head;
+    linkedlist_node_t *ahead = linkedlist_prefetchstart(curr, 0);
+    size_t i;
+
+    LINKEDLIST_BEGIN(view->list, LINKEDLIST_OP_VIEW_FIND, view->index);
+
+    /* Test each item until an item passes the test. */
+    for (i = 0; i < view->size; i++) {
+        LINKEDLIST_WALK(view->list, 1);
+        ahead = linkedlist_prefetchnext(ahead, 0);
+        if (f(curr->data) == 1) {
+            return curr->data;
+        }
+        curr = curr->next;
+    }
+    return NULL;
+}
+
+int linkedlist_view_foreach(linkedlist_view_t *view, void (*f)(void *)) {
+    linkedlist_node_t *curr = view->head;
+    linkedlist_node_t *ahead = linkedlist_prefetchstart(curr, 0);
+    size_t i;
+
+    LINKEDLIST_BEGIN(view->list, LINKEDLIST_OP_VIEW_FOREACH, view->index);
+
+    /* Execute function on every item in the view. */
+    for (i = 0; i < view->size; i++) {
+        LINKEDLIST_WALK(view->list, 1);
+        ahead = linkedlist_prefetchnext(ahead, 0);
+        f(curr->data);
+        curr = curr->next;
+    }
+    return 0;
+}
+
+int linkedlist_view_toarray(linkedlist_view_t *view, void *dest[]) {
+    linkedlist_node_t *curr = view->head;
+    size_t index;
+
+    LINKEDLIST_BEGIN(view->list, LINKEDLIST_OP_VIEW_TOARRAY, view->index);
+    LINKEDLIST_WALK(view->list, view->size);
+
+    /* Copies each item from the view to the array. */
+    for (index = 0; index < view->size; index++) {
+        dest[index] = curr->data;
+        curr = curr->next;
+    }
+    dest[index] = NULL;
+    return 0;
+}
+
 
 int linkedlist_slice(linkedlist_t *list, size_t start, size_t end) {
     size_t size;
     linkedlist_node_t *curr, *next;
 
+    LINKEDLIST_BEGIN(list, LINKEDLIST_OP_SLICE, start);
+
     /* Slice to empty list. */
     if (start >= end || start >= list->size) {
         return linkedlist_destroy(list);
@@ -463,17 +1800,20 @@ int linkedlist_slice(linkedlist_t *list, size_t start, size_t end) {
         end = list->size;
     }
     size = end - start;
+    linkedlist_forget(list);
+    LINKEDLIST_WALK(list, list->size);
 
     /* Free nodes until start. */
     curr = list->head;
     while (start-- > 0) {
         next = curr->next;
-        free(curr);
+        linkedlist_node_free(list, curr);
         list->size--;
         curr = next;
     }
     /* Assign new list head. */
     list->head = curr;
+    curr->prev = NULL;
 
     /* Iterate until before end. */
     while (--size > 0) {
@@ -488,17 +1828,86 @@ int linkedlist_slice(linkedlist_t *list, size_t start, size_t end) {
     curr = next;
     while (curr) {
         next = curr->next;
-        free(curr);
+        linkedlist_node_free(list, curr);
         list->size--;
         curr = next;
     }
     return 0;
 }
 
+int linkedlist_split(linkedlist_t *src, size_t index, linkedlist_t *dest) {
+    linkedlist_node_t *node, *head, *foot;
+    size_t size;
+
+    LINKEDLIST_BEGIN(src, LINKEDLIST_OP_SPLIT, index);
+
+    /* Cannot split from index beyond list size. */
+    if (index > src->size) {
+        fprintf(stderr, "List out of range\n");
+        return 1;
+    }
+
+    /* Create a new empty list for dest, allocating nodes the same way. */
+    linkedlist_createlike(dest, src);
+    if (index == src->size) {
+        return 0;
+    }
+    node = linkedlist_node_at(src, index);
+
+    /* Copy nodes if src has a pool of its own. */
+    if (!linkedlist_sharesnodes(dest, src)) {
+        head = linkedlist_copychain(dest, node, &foot, &size);
+        if (!head) {
+            return 1;
+        }
+        LINKEDLIST_WALK(src, size);
+        linkedlist_insertchain(dest, NULL, head, foot, size);
+        return linkedlist_slice(src, 0, index);
+    }
+
+    /* Move nodes from index onwards to dest. */
+    dest->head = node;
+    dest->foot = src->foot;
+    dest->size = src->size - index;
+    if (index == 0) {
+        linkedlist_reset(src);
+    } else {
+        src->foot = node->prev;
+        src->foot->next = NULL;
+        src->size = index;
+        linkedlist_forget(src);
+    }
+    node->prev = NULL;
+    return 0;
+}
+
+int linkedlist_rotate(linkedlist_t *list, size_t count) {
+    linkedlist_node_t *head;
+
+    LINKEDLIST_BEGIN(list, LINKEDLIST_OP_ROTATE, count);
+    if (list->size == 0 || (count %= list->size) == 0) {
+        return 0;
+    }
+
+    /* Join list foot to list head and break the ring before count. */
+    head = linkedlist_node_at(list, count);
+    list->foot->next = list->head;
+    list->head->prev = list->foot;
+    list->foot = head->prev;
+    list->foot->next = NULL;
+    head->prev = NULL;
+    list->head = head;
+    linkedlist_forget(list);
+    return 0;
+}
+
 int linkedlist_toarray(linkedlist_t *src, void *dest[]) {
     linkedlist_node_t *curr = src->head;
     size_t index = 0;
 
+    LINKEDLIST_BEGIN(src, LINKEDLIST_OP_TOARRAY, 0);
+    LINKEDLIST_WALK(src, src->size);
+
     /* Copies each item from the list to the array. */
     while (curr) {
         dest[index] = curr->data;
@@ -509,36 +1918,533 @@ int linkedlist_toarray(linkedlist_t *src, void *dest[]) {
     return 0;
 }
 
-int linkedlist_reverse(linkedlist_t *list) {
-    size_t i, size = list->size;
-    void **array = (void**)malloc(sizeof *array * (size + 1));
-    if (!array) {
+/* Header of saved lists: magic number, format version, flags, pointer size
+ * and number of items.
+ */
+#define IO_MAGIC 0x4c4c5354
+#define IO_VERSION 1
+#define IO_CODEC 1
+#define IO_HEADER (4 * sizeof(uint32_t) + sizeof(uint64_t))
+
+typedef struct linkedlist_io_t {
+    FILE *file;
+    unsigned char *buffer;
+    size_t size;
+    size_t start;
+    size_t end;
+    size_t left;
+} linkedlist_io_t;
+
+static int linkedlist_io_create(linkedlist_io_t *io, FILE *file) {
+    io->file = file;
+    io->size = LINKEDLIST_IO_BUFFER;
+    io->start = io->end = io->left = 0;
+    io->buffer = (unsigned char*)malloc(io->size);
+    if (!io->buffer) {
         fprintf(stderr, "Out of memory\n");
         return 1;
     }
+    return 0;
+}
 
-    linkedlist_toarray(list, array);
-    linkedlist_destroy(list);
-    for (i = size; i-- > 0; ) {
-        linkedlist_push(list, array[i]);
+static int linkedlist_io_grow(linkedlist_io_t *io, size_t size) {
+    unsigned char *buffer;
+
+    /* Grow the buffer to hold an item larger than it. */
+    if (size <= io->size) {
+        return 0;
     }
+    buffer = (unsigned char*)realloc(io->buffer, size);
+    if (!buffer) {
+        fprintf(stderr, "Out of memory\n");
+        return 1;
+    }
+    io->buffer = buffer;
+    io->size = size;
+    return 0;
+}
 
-    free(array);
+static int linkedlist_io_flush(linkedlist_io_t *io) {
+    /* Write the buffered bytes. */
+    if (io->end > 0 && fwrite(io->buffer, 1, io->end, io->file) != io->end) {
+        fprintf(stderr, "Cannot write file\n");
+        return 1;
+    }
+    io->end = 0;
     return 0;
 }
 
+static unsigned char *linkedlist_io_space(linkedlist_io_t *io, size_t size) {
+    /* Make room to write size bytes to the buffer. */
+    if (io->size - io->end < size) {
+        if (linkedlist_io_flush(io) || linkedlist_io_grow(io, size)) {
+            return NULL;
+        }
+    }
+    return io->buffer + io->end;
+}
+
+static unsigned char *linkedlist_io_fill(linkedlist_io_t *io, size_t size) {
+    unsigned char *data;
+    size_t bytes;
+
+    /* Read until size bytes are in the buffer, keeping the unread bytes. Read
+     * no further than the bytes left in the list, so that whatever follows it
+     * in the file stays unread.
+     */
+    if (io->end - io->start < size) {
+        memmove(io->buffer, io->buffer + io->start, io->end - io->start);
+        io->end -= io->start;
+        io->start = 0;
+        if (linkedlist_io_grow(io, size)) {
+            return NULL;
+        }
+        bytes = io->size - io->end < io->left ? io->size - io->end : io->left;
+        bytes = fread(io->buffer + io->end, 1, bytes, io->file);
+        io->end += bytes;
+        io->left -= bytes;
+        if (io->end < size) {
+            fprintf(stderr, "Cannot read file\n");
+            return NULL;
+        }
+    }
+    data = io->buffer + io->start;
+    io->start += size;
+    return data;
+}
+
+int linkedlist_save(linkedlist_t *src, FILE *file, linkedlist_codec_t *codec) {
+    linkedlist_node_t *curr;
+    linkedlist_io_t io;
+    unsigned char *buffer;
+    uint32_t header[4], length;
+    uint64_t count = src->size;
+    size_t size;
+
+    LINKEDLIST_BEGIN(src, LINKEDLIST_OP_SAVE, 0);
+    LINKEDLIST_WALK(src, src->size);
+    if (linkedlist_io_create(&io, file)) {
+        return 1;
+    }
+
+    /* Write the header. */
+    header[0] = IO_MAGIC;
+    header[1] = IO_VERSION;
+    header[2] = codec ? IO_CODEC : 0;
+    header[3] = sizeof(void *);
+    buffer = linkedlist_io_space(&io, IO_HEADER);
+    if (!buffer) {
+        free(io.buffer);
+        return 1;
+    }
+    memcpy(buffer, header, sizeof header);
+    memcpy(buffer + sizeof header, &count, sizeof count);
+    io.end = IO_HEADER;
+
+    /* Write each item's pointer, or its length and encoded payload. */
+    for (curr = src->head; curr; curr = curr->next) {
+        if (!codec) {
+            buffer = linkedlist_io_space(&io, sizeof(void *));
+            if (!buffer) {
+                break;
+            }
+            memcpy(buffer, &curr->data, sizeof(void *));
+            io.end += sizeof(void *);
+            continue;
+        }
+
+        /* Encode into the free space, making more room if it does not fit. */
+        buffer = linkedlist_io_space(&io, sizeof length);
+        if (!buffer) {
+            break;
+        }
+        size = codec->encode(curr->data, buffer + sizeof length,
+            io.size - io.end - sizeof length);
+        if (size > UINT32_MAX) {
+            fprintf(stderr, "Item is too large to save\n");
+            break;
+        }
+        if (size > io.size - io.end - sizeof length) {
+            buffer = linkedlist_io_space(&io, sizeof length + size);
+            if (!buffer) {
+                break;
+            }
+            codec->encode(curr->data, buffer + sizeof length, size);
+        }
+        length = (uint32_t)size;
+        memcpy(buffer, &length, sizeof length);
+        io.end += sizeof length + size;
+    }
+
+    if (curr || linkedlist_io_flush(&io)) {
+        free(io.buffer);
+        return 1;
+    }
+    free(io.buffer);
+    return 0;
+}
+
+int linkedlist_load(linkedlist_t *dest, linkedlist_pool_t *pool, FILE *file,
+    linkedlist_codec_t *codec) {
+    linkedlist_node_t *head, *curr, *foot, *prev = NULL;
+    linkedlist_io_t io;
+    unsigned char *buffer;
+    uint32_t header[4], length;
+    uint64_t count;
+    size_t size = 0;
+
+    /* Create a new empty list for dest, allocating nodes from a pool. */
+    linkedlist_createpooled(dest, pool);
+    LINKEDLIST_BEGIN(dest, LINKEDLIST_OP_LOAD, 0);
+    if (linkedlist_io_create(&io, file)) {
+        return 1;
+    }
+
+    /* Read and check the header. */
+    io.left = IO_HEADER;
+    buffer = linkedlist_io_fill(&io, IO_HEADER);
+    if (!buffer) {
+        free(io.buffer);
+        return 1;
+    }
+    memcpy(header, buffer, sizeof header);
+    memcpy(&count, buffer + sizeof header, sizeof count);
+    if (header[0] != IO_MAGIC || header[1] != IO_VERSION
+        || header[2] != (codec ? IO_CODEC : 0u)
+        || (!codec && header[3] != sizeof(void *))
+        || count > (SIZE_MAX - sizeof(linkedlist_chunk_t))
+        / sizeof(linkedlist_node_t)) {
+        fprintf(stderr, "File is not a list saved this way\n");
+        free(io.buffer);
+        return 1;
+    }
+    if (count == 0) {
+        free(io.buffer);
+        return 0;
+    }
+
+    /* Allocate every node at once. */
+    head = linkedlist_node_allocchain(dest, (size_t)count);
+    if (!head) {
+        free(io.buffer);
+        return 1;
+    }
+
+    /* Read each item's pointer, or its length and encoded payload followed by
+     * the next item's length.
+     */
+    io.left = codec ? sizeof length : (size_t)count * sizeof(void *);
+    for (curr = head; curr; curr = curr->next) {
+        if (!codec) {
+            buffer = linkedlist_io_fill(&io, sizeof(void *));
+            if (!buffer) {
+                break;
+            }
+            memcpy(&curr->data, buffer, sizeof(void *));
+        } else {
+            buffer = linkedlist_io_fill(&io, sizeof length);
+            if (!buffer) {
+                break;
+            }
+            memcpy(&length, buffer, sizeof length);
+            io.left += length + (curr->next ? sizeof length : 0);
+            buffer = linkedlist_io_fill(&io, length);
+            if (!buffer || codec->decode(buffer, length, &curr->data)) {
+                break;
+            }
+        }
+        curr->prev = prev;
+        prev = curr;
+        size++;
+    }
+    free(io.buffer);
+
+    /* Keep the items read, so that their payloads may be freed on failure. */
+    if (curr) {
+        foot = curr;
+        while (foot->next) {
+            foot = foot->next;
+        }
+        linkedlist_node_freechain(dest, curr, foot, (size_t)count - size);
+        if (prev) {
+            prev->next = NULL;
+        } else {
+            head = NULL;
+        }
+    }
+    dest->head = head;
+    dest->foot = prev;
+    dest->size = size;
+    return curr ? 1 : 0;
+}
+
+int linkedlist_reverse(linkedlist_t *list) {
+    linkedlist_node_t *curr = list->head, *next;
+
+    LINKEDLIST_BEGIN(list, LINKEDLIST_OP_REVERSE, 0);
+    LINKEDLIST_WALK(list, list->size);
+
+    /* Swap the links of every node. */
+    while (curr) {
+        next = curr->next;
+        curr->next = curr->prev;
+        curr->prev = next;
+        curr = next;
+    }
+
+    /* Swap list head and foot. */
+    curr = list->head;
+    list->head = list->foot;
+    list->foot = curr;
+    linkedlist_forget(list);
+    return 0;
+}
+
+static linkedlist_node_t *linkedlist_merge(linkedlist_t *list,
+    linkedlist_node_t *a, linkedlist_node_t *b,
+    int (*f)(const void *, const void *)) {
+    linkedlist_node_t head, *tail = &head;
+
+    /* Merge two sorted chains, taking from a first on ties to stay stable. */
+    while (a && b) {
+        LINKEDLIST_WALK(list, 1);
+        if (f(&a->data, &b->data) <= 0) {
+            tail->next = a;
+            a = a->next;
+        } else {
+            tail->next = b;
+            b = b->next;
+        }
+        tail = tail->next;
+    }
+    tail->next = a ? a : b;
+    return head.next;
+}
+
 int linkedlist_sort(linkedlist_t *list, int (*f)(const void *, const void *)) {
-    size_t size = list->size;
-    void **array = (void**)malloc(sizeof *array * (size + 1));
-    if (!array) {
+    linkedlist_node_t *runs[sizeof(size_t) * 8] = { NULL };
+    linkedlist_node_t *curr = list->head, *run, *last, *next, *prev;
+    size_t i, nruns = 0;
+
+    LINKEDLIST_BEGIN(list, LINKEDLIST_OP_SORT, 0);
+    if (list->size < 2) {
+        return 0;
+    }
+    LINKEDLIST_WALK(list, list->size * 2);
+
+    /* Split the list into sorted runs and merge runs of similar lengths. */
+    while (curr) {
+        run = last = curr;
+        curr = curr->next;
+        if (curr && f(&curr->data, &last->data) < 0) {
+            /* Reverse a strictly descending run while it is being found. */
+            run->next = NULL;
+            while (curr && f(&curr->data, &run->data) < 0) {
+                next = curr->next;
+                curr->next = run;
+                run = curr;
+                curr = next;
+            }
+        } else {
+            /* Extend an ascending run. */
+            while (curr && f(&curr->data, &last->data) >= 0) {
+                last = curr;
+                curr = curr->next;
+            }
+            last->next = NULL;
+        }
+
+        for (i = 0; runs[i]; i++) {
+            run = linkedlist_merge(list, runs[i], run, f);
+            runs[i] = NULL;
+        }
+        runs[i] = run;
+        if (i >= nruns) {
+            nruns = i + 1;
+        }
+    }
+
+    /* Merge the remaining runs, earlier items being in later runs. */
+    run = NULL;
+    for (i = 0; i < nruns; i++) {
+        if (runs[i]) {
+            run = run ? linkedlist_merge(list, runs[i], run, f) : runs[i];
+        }
+    }
+
+    /* Relink prev pointers and assign new list head and foot. */
+    linkedlist_forget(list);
+    list->head = run;
+    prev = NULL;
+    for (curr = run; curr; curr = curr->next) {
+        curr->prev = prev;
+        prev = curr;
+    }
+    list->foot = prev;
+    return 0;
+}
+
+typedef struct linkedlist_keyed_t {
+    uint64_t key;
+    linkedlist_node_t *node;
+} linkedlist_keyed_t;
+
+int linkedlist_sortkey(linkedlist_t *list, uint64_t (*f)(void *)) {
+    linkedlist_keyed_t *items, *sorted, *swap;
+    linkedlist_node_t *curr = list->head, *prev = NULL;
+    size_t counts[sizeof(uint64_t)][256], i, byte, offset, count;
+    unsigned shift;
+
+    LINKEDLIST_BEGIN(list, LINKEDLIST_OP_SORTKEY, 0);
+    if (list->size < 2) {
+        return 0;
+    }
+    items = (linkedlist_keyed_t*)malloc(2 * list->size * sizeof *items);
+    if (!items) {
+        fprintf(stderr, "Out of memory\n");
+        return 1;
+    }
+    sorted = items + list->size;
+    LINKEDLIST_WALK(list, list->size * 2);
+
+    /* Get every key once, counting each of its bytes. */
+    memset(counts, 0, sizeof counts);
+    for (i = 0; curr; curr = curr->next, i++) {
+        items[i].key = f(curr->data);
+        items[i].node = curr;
+        for (byte = 0; byte < sizeof(uint64_t); byte++) {
+            counts[byte][(items[i].key >> (byte * 8)) & 0xff]++;
+        }
+    }
+
+    /* Place items by each byte from the lowest, which keeps the order of
+     * items with equal bytes, skipping bytes which every key shares.
+     */
+    for (byte = 0; byte < sizeof(uint64_t); byte++) {
+        shift = (unsigned)byte * 8;
+        if (counts[byte][(items[0].key >> shift) & 0xff] == list->size) {
+            continue;
+        }
+        for (i = 0, offset = 0; i < 256; i++) {
+            count = counts[byte][i];
+            counts[byte][i] = offset;
+            offset += count;
+        }
+        for (i = 0; i < list->size; i++) {
+            sorted[counts[byte][(items[i].key >> shift) & 0xff]++] = items[i];
+        }
+        swap = items;
+        items = sorted;
+        sorted = swap;
+    }
+
+    /* Relink nodes in order and assign new list head and foot. */
+    linkedlist_forget(list);
+    for (i = 0; i < list->size; i++) {
+        curr = items[i].node;
+        curr->prev = prev;
+        if (prev) {
+            prev->next = curr;
+        }
+        prev = curr;
+    }
+    prev->next = NULL;
+    list->head = items[0].node;
+    list->foot = prev;
+    free(items < sorted ? items : sorted);
+    return 0;
+}
+
+int linkedlist_compact(linkedlist_t *list) {
+    linkedlist_pool_t *pool = list->pool;
+    linkedlist_chunk_t *chunk;
+    linkedlist_node_t *curr = list->head, *node;
+    size_t i;
+
+    LINKEDLIST_BEGIN(list, LINKEDLIST_OP_COMPACT, 0);
+    if (list->size == 0) {
+        return 0;
+    }
+
+    /* Allocate one chunk to hold every node, and a pool of the list's own to
+     * hold the chunk if the list allocates each node with malloc.
+     */
+    chunk = (linkedlist_chunk_t*)malloc(sizeof *chunk
+        + sizeof chunk->nodes[0] * list->size);
+    if (!pool) {
+        pool = (linkedlist_pool_t*)malloc(sizeof *pool);
+    }
+    if (!chunk || !pool) {
+        free(chunk);
+        if (pool != list->pool) {
+            free(pool);
+        }
         fprintf(stderr, "Out of memory\n");
         return 1;
     }
+    chunk->size = list->size;
+    LINKEDLIST_ALLOC(list, list->size);
+    LINKEDLIST_WALK(list, list->size);
+
+    /* Copy items into the chunk in list order, linking each node to the
+     * nodes beside it.
+     */
+    for (i = 0; i < list->size; i++) {
+        node = &chunk->nodes[i];
+        node->data = curr->data;
+        node->prev = i > 0 ? node - 1 : NULL;
+        node->next = i + 1 < list->size ? node + 1 : NULL;
+        curr = curr->next;
+    }
+
+    /* Free the old nodes, then add the chunk to the pool. */
+    if (list->ownspool) {
+        /* Free the list's own pool's chunks, which hold no other nodes. */
+        LINKEDLIST_FREE(list, list->size);
+        linkedlist_pool_destroy(pool);
+        chunk->next = NULL;
+        pool->chunks = chunk;
+        pool->carved = chunk->size;
+    } else if (list->pool) {
+        /* Keep carving from the shared pool's newest chunk. */
+        linkedlist_node_freechain(list, list->head, list->foot, list->size);
+        chunk->next = pool->chunks->next;
+        pool->chunks->next = chunk;
+    } else {
+        linkedlist_node_freechain(list, list->head, list->foot, list->size);
+        linkedlist_pool_create(pool, 0);
+        chunk->next = NULL;
+        pool->chunks = chunk;
+        pool->carved = chunk->size;
+        list->pool = pool;
+        list->ownspool = 1;
+    }
 
-    linkedlist_toarray(list, array);
-    linkedlist_destroy(list);
-    qsort(array, size, sizeof *array, f);
-    linkedlist_addarray(list, array);
-    free(array);
+    /* Assign new list head and foot. */
+    linkedlist_forget(list);
+    list->head = &chunk->nodes[0];
+    list->foot = &chunk->nodes[list->size - 1];
+    return 0;
+}
+
+int linkedlist_invalidate(linkedlist_t *list) {
+    LINKEDLIST_BEGIN(list, LINKEDLIST_OP_INVALIDATE, 0);
+    linkedlist_forget(list);
+    return 0;
+}
+
+int linkedlist_cache(linkedlist_t *list, int on) {
+    LINKEDLIST_BEGIN(list, LINKEDLIST_OP_CACHE, 0);
+    linkedlist_forget(list);
+    list->cache = on;
+
+    /* Free the memory kept for caching once it is turned off. */
+    if (!on) {
+        free(list->checkpoints);
+        list->checkpoints = NULL;
+        free(list->snapshot);
+        list->snapshot = NULL;
+        list->snapshotcapacity = 0;
+    }
     return 0;
 }
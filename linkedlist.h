@@ -1,24 +1,174 @@
 /*
  * linkedlist.h
- * Version 20160927
+ * Version 20261018
  * Written by Harry Wong (RedAndBlueEraser)
  */
 
+#ifndef LINKEDLIST_H
+#define LINKEDLIST_H
+
 #include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
 
 typedef struct linkedlist_node_t {
     struct linkedlist_node_t *next;
+    struct linkedlist_node_t *prev;
     void *data;
 } linkedlist_node_t;
 
+typedef struct linkedlist_chunk_t {
+    struct linkedlist_chunk_t *next;
+    size_t size;
+    linkedlist_node_t nodes[];
+} linkedlist_chunk_t;
+
+typedef struct linkedlist_pool_t {
+    linkedlist_chunk_t *chunks;
+    linkedlist_node_t *free;
+    size_t chunksize;
+    size_t carved;
+} linkedlist_pool_t;
+
+#ifdef LINKEDLIST_STATS
+typedef enum linkedlist_op_t {
+    LINKEDLIST_OP_CREATE,
+    LINKEDLIST_OP_CREATEPOOLED,
+    LINKEDLIST_OP_DESTROY,
+    LINKEDLIST_OP_CLONE,
+    LINKEDLIST_OP_SIZE,
+    LINKEDLIST_OP_ISEMPTY,
+    LINKEDLIST_OP_PUSH,
+    LINKEDLIST_OP_POP,
+    LINKEDLIST_OP_UNSHIFT,
+    LINKEDLIST_OP_SHIFT,
+    LINKEDLIST_OP_PUSHN,
+    LINKEDLIST_OP_POPN,
+    LINKEDLIST_OP_SHIFTN,
+    LINKEDLIST_OP_ADD,
+    LINKEDLIST_OP_REMOVE,
+    LINKEDLIST_OP_SET,
+    LINKEDLIST_OP_ADDARRAY,
+    LINKEDLIST_OP_REMOVEARRAY,
+    LINKEDLIST_OP_REMOVEARRAYALL,
+    LINKEDLIST_OP_ADDLINKEDLIST,
+    LINKEDLIST_OP_REMOVELINKEDLIST,
+    LINKEDLIST_OP_REMOVELINKEDLISTALL,
+    LINKEDLIST_OP_CONCAT,
+    LINKEDLIST_OP_SPLICE,
+    LINKEDLIST_OP_GET,
+    LINKEDLIST_OP_FIRST,
+    LINKEDLIST_OP_LAST,
+    LINKEDLIST_OP_INDEXOF,
+    LINKEDLIST_OP_INDEXOFANY,
+    LINKEDLIST_OP_FIND,
+    LINKEDLIST_OP_FINDINDEX,
+    LINKEDLIST_OP_FOREACH,
+    LINKEDLIST_OP_FOREACHREVERSE,
+    LINKEDLIST_OP_CURSOR_BEGIN,
+    LINKEDLIST_OP_CURSOR_BEGINREVERSE,
+    LINKEDLIST_OP_CURSOR_ISEND,
+    LINKEDLIST_OP_CURSOR_NEXT,
+    LINKEDLIST_OP_CURSOR_PREV,
+    LINKEDLIST_OP_CURSOR_INDEX,
+    LINKEDLIST_OP_CURSOR_GET,
+    LINKEDLIST_OP_CURSOR_SET,
+    LINKEDLIST_OP_CURSOR_INSERTAFTER,
+    LINKEDLIST_OP_CURSOR_REMOVE,
+    LINKEDLIST_OP_VIEW_CREATE,
+    LINKEDLIST_OP_VIEW_FROMCURSOR,
+    LINKEDLIST_OP_VIEW_SIZE,
+    LINKEDLIST_OP_VIEW_INDEXOF,
+    LINKEDLIST_OP_VIEW_FIND,
+    LINKEDLIST_OP_VIEW_FOREACH,
+    LINKEDLIST_OP_VIEW_TOARRAY,
+    LINKEDLIST_OP_SLICE,
+    LINKEDLIST_OP_SPLIT,
+    LINKEDLIST_OP_ROTATE,
+    LINKEDLIST_OP_TOARRAY,
+    LINKEDLIST_OP_SAVE,
+    LINKEDLIST_OP_LOAD,
+    LINKEDLIST_OP_REVERSE,
+    LINKEDLIST_OP_SORT,
+    LINKEDLIST_OP_SORTKEY,
+    LINKEDLIST_OP_COMPACT,
+    LINKEDLIST_OP_INVALIDATE,
+    LINKEDLIST_OP_CACHE,
+    LINKEDLIST_OPS
+} linkedlist_op_t;
+
+typedef struct linkedlist_stats_t {
+    size_t calls[LINKEDLIST_OPS];
+    size_t traversed;
+    size_t maxwalk;
+    size_t allocs;
+    size_t frees;
+    size_t bytes;
+    linkedlist_op_t op;
+    size_t index;
+    size_t walk;
+} linkedlist_stats_t;
+#endif
+
 typedef struct linkedlist_t {
     linkedlist_node_t *head;
     linkedlist_node_t *foot;
     size_t size;
+    linkedlist_pool_t *pool;
+    int ownspool;
+    int cache;
+    linkedlist_node_t *finger;
+    size_t fingerindex;
+    linkedlist_node_t **checkpoints;
+    size_t checkpointcount;
+    size_t checkpointstride;
+    void **snapshot;
+    size_t snapshotcapacity;
+    size_t searches;
+#ifdef LINKEDLIST_STATS
+    linkedlist_stats_t stats;
+#endif
 } linkedlist_t;
 
+typedef struct linkedlist_codec_t {
+    size_t (*encode)(void *data, void *buffer, size_t size);
+    int (*decode)(const void *buffer, size_t size, void **data);
+} linkedlist_codec_t;
+
+typedef struct linkedlist_cursor_t {
+    linkedlist_t *list;
+    linkedlist_node_t *node;
+    size_t index;
+} linkedlist_cursor_t;
+
+typedef struct linkedlist_view_t {
+    linkedlist_t *list;
+    linkedlist_node_t *head;
+    size_t index;
+    size_t size;
+} linkedlist_view_t;
+
+/* Functions which only read the items do not change the list struct, so
+ * several threads may read a list at once, unless the list caches or
+ * LINKEDLIST_STATS counts every call. A list which caches (see
+ * linkedlist_cache()) remembers the node accessed by position, counts and packs
+ * searched items, and records checkpoints for the parallel functions, so calls
+ * on it, even to read it, must not be made from more than one thread at a time.
+ */
+
+/* Create a new empty node pool which allocates chunksize nodes at a time (or a
+ * default amount if chunksize is 0). Returns 0 on success.
+ */
+int linkedlist_pool_create(linkedlist_pool_t *pool, size_t chunksize);
+/* Free all memory allocated by the node pool. Returns 0 on success. */
+int linkedlist_pool_destroy(linkedlist_pool_t *pool);
+
 /* Create a new empty list. Returns 0 on success. */
 int linkedlist_create(linkedlist_t *list);
+/* Create a new empty list which allocates nodes from the pool (or from a pool
+ * of its own if pool is null). Returns 0 on success.
+ */
+int linkedlist_createpooled(linkedlist_t *list, linkedlist_pool_t *pool);
 /* Empty the list. Returns 0 on success. */
 int linkedlist_destroy(linkedlist_t *list);
 /* Copies a list. */
@@ -37,6 +187,19 @@ void *linkedlist_pop(linkedlist_t *list);
 int linkedlist_unshift(linkedlist_t *list, void *data);
 /* Remove and return the item on the start of the list. */
 void *linkedlist_shift(linkedlist_t *list);
+/* Add count items from the array to the end of the list, carving their nodes
+ * from at most one new allocation if the list uses a pool. Returns 0 on
+ * success.
+ */
+int linkedlist_pushn(linkedlist_t *list, void *src[], size_t count);
+/* Remove up to count items from the end of the list into the array, in the
+ * order they are popped. Returns the number of items removed.
+ */
+size_t linkedlist_popn(linkedlist_t *list, void *dest[], size_t count);
+/* Remove up to count items from the start of the list into the array, in the
+ * order they are shifted. Returns the number of items removed.
+ */
+size_t linkedlist_shiftn(linkedlist_t *list, void *dest[], size_t count);
 /* Add an item to the specified position in the list. Returns 0 on success. */
 int linkedlist_add(linkedlist_t *list, size_t index, void *data);
 /* Remove and return the item in the specified position of the list. */
@@ -52,12 +215,28 @@ int linkedlist_addarray(linkedlist_t *dest, void *src[]);
  * success.
  */
 int linkedlist_removearray(linkedlist_t *dest, void *src[]);
+/* Remove every occurrence of the items in the null-terminated array from the
+ * list. Returns 0 on success.
+ */
+int linkedlist_removearrayall(linkedlist_t *dest, void *src[]);
 /* Add the items from the src list to the end of the dest list. Returns 0 on
  * success.
  */
 int linkedlist_addlinkedlist(linkedlist_t *dest, linkedlist_t *src);
 /* Remove the items in the src list from the dest list. Returns 0 on success. */
 int linkedlist_removelinkedlist(linkedlist_t *dest, linkedlist_t *src);
+/* Remove every occurrence of the items in the src list from the dest list.
+ * Returns 0 on success.
+ */
+int linkedlist_removelinkedlistall(linkedlist_t *dest, linkedlist_t *src);
+/* Move the items from the src list to the end of the dest list, leaving src
+ * empty. Returns 0 on success.
+ */
+int linkedlist_concat(linkedlist_t *dest, linkedlist_t *src);
+/* Move the items from the src list to the specified position in the dest list,
+ * leaving src empty. Returns 0 on success.
+ */
+int linkedlist_splice(linkedlist_t *dest, size_t index, linkedlist_t *src);
 
 /* Get and return the item in the specified position in the list. */
 void *linkedlist_get(linkedlist_t *list, size_t index);
@@ -69,6 +248,11 @@ void *linkedlist_last(linkedlist_t *list);
  * number of items in the list if the item is not found.
  */
 size_t linkedlist_indexof(linkedlist_t *list, void *data);
+/* Find and return the index of the first item in the list which is any of the
+ * items in the null-terminated array. Returns the number of items in the list
+ * if none of the items are found.
+ */
+size_t linkedlist_indexofany(linkedlist_t *list, void *data[]);
 /* Find and return the first item in the list that pass the test (provided as a
  * function where a pass is 1). Returns null if no items pass the test.
  */
@@ -82,14 +266,127 @@ size_t linkedlist_findindex(linkedlist_t *list, int (*f)(void *));
  * success.
  */
 int linkedlist_foreach(linkedlist_t *list, void (*f)(void *));
+/* Iterate over the list from the end and execute a function on each item.
+ * Returns 0 on success.
+ */
+int linkedlist_foreachreverse(linkedlist_t *list, void (*f)(void *));
+
+/* Point the cursor at the first item in the list. Returns 0 on success. */
+int linkedlist_cursor_begin(linkedlist_t *list, linkedlist_cursor_t *cursor);
+/* Point the cursor at the last item in the list. Returns 0 on success. */
+int linkedlist_cursor_beginreverse(linkedlist_t *list,
+    linkedlist_cursor_t *cursor);
+/* Check if the cursor has moved past either end of the list. */
+int linkedlist_cursor_isend(linkedlist_cursor_t *cursor);
+/* Move the cursor to the next item. Returns 0 on success. */
+int linkedlist_cursor_next(linkedlist_cursor_t *cursor);
+/* Move the cursor to the previous item. Returns 0 on success. */
+int linkedlist_cursor_prev(linkedlist_cursor_t *cursor);
+/* Get and return the index of the item at the cursor. */
+size_t linkedlist_cursor_index(linkedlist_cursor_t *cursor);
+/* Get and return the item at the cursor. */
+void *linkedlist_cursor_get(linkedlist_cursor_t *cursor);
+/* Replace the item at the cursor. Returns 0 on success. */
+int linkedlist_cursor_set(linkedlist_cursor_t *cursor, void *data);
+/* Add an item after the item at the cursor. Returns 0 on success. */
+int linkedlist_cursor_insertafter(linkedlist_cursor_t *cursor, void *data);
+/* Remove and return the item at the cursor, moving the cursor to the next
+ * item.
+ */
+void *linkedlist_cursor_remove(linkedlist_cursor_t *cursor);
+
+/* Point the view at the items of the list from including start to excluding
+ * end, without copying them. Returns 0 on success.
+ */
+int linkedlist_view_create(linkedlist_t *list, size_t start, size_t end,
+    linkedlist_view_t *view);
+/* Point the view at up to count items of the list from the item at the
+ * cursor, without walking the list. Returns 0 on success.
+ */
+int linkedlist_view_fromcursor(linkedlist_cursor_t *cursor, size_t count,
+    linkedlist_view_t *view);
+/* Get and return the number of items in the view. */
+size_t linkedlist_view_size(linkedlist_view_t *view);
+/* Find and return the index of the specified item in the view. Returns the
+ * number of items in the view if the item is not found.
+ */
+size_t linkedlist_view_indexof(linkedlist_view_t *view, void *data);
+/* Find and return the first item in the view that pass the test (provided as a
+ * function where a pass is 1). Returns null if no items pass the test.
+ */
+void *linkedlist_view_find(linkedlist_view_t *view, int (*f)(void *));
+/* Iterate over the view and execute a function on each item. Returns 0 on
+ * success.
+ */
+int linkedlist_view_foreach(linkedlist_view_t *view, void (*f)(void *));
+/* Represents the view as a null-terminated array. Returns 0 on success. */
+int linkedlist_view_toarray(linkedlist_view_t *view, void *dest[]);
 
 /* Slice the list from including start to excluding end. Returns 0 on
  * success.
  */
 int linkedlist_slice(linkedlist_t *list, size_t start, size_t end);
+/* Move the items from the specified position onwards in the src list to a new
+ * dest list. Returns 0 on success.
+ */
+int linkedlist_split(linkedlist_t *src, size_t index, linkedlist_t *dest);
+/* Move the specified number of items from the start to the end of the list.
+ * Returns 0 on success.
+ */
+int linkedlist_rotate(linkedlist_t *list, size_t count);
 /* Represents the list as a null-terminated array. Returns 0 on success. */
 int linkedlist_toarray(linkedlist_t *src, void *dest[]);
+/* Write the list to a file, with each item's payload encoded by the codec (or
+ * each item's pointer itself if codec is null). Returns 0 on success.
+ */
+int linkedlist_save(linkedlist_t *src, FILE *file, linkedlist_codec_t *codec);
+/* Read a list written by linkedlist_save() from a file into a new dest list,
+ * which allocates its nodes at once from the pool (or from a pool of its own
+ * if pool is null). Returns 0 on success.
+ */
+int linkedlist_load(linkedlist_t *dest, linkedlist_pool_t *pool, FILE *file,
+    linkedlist_codec_t *codec);
 /* Reverse the order of items in the list. Returns 0 on success. */
 int linkedlist_reverse(linkedlist_t *list);
-/* Sort the items in the list. Returns 0 on success. */
+/* Sort the items in the list, keeping the order of equal items. Returns 0 on
+ * success.
+ */
 int linkedlist_sort(linkedlist_t *list, int (*f)(const void *, const void *));
+/* Sort the items in the list by an unsigned integer key (provided as a function
+ * which returns the key of an item), keeping the order of equal items.
+ * Returns 0 on success.
+ */
+int linkedlist_sortkey(linkedlist_t *list, uint64_t (*f)(void *));
+/* Move every node of the list into one block of memory in list order, so that
+ * walking the list reads memory in order, without changing any items. Moves
+ * the nodes from under any cursors on the list. A list which allocated each
+ * node with malloc allocates from a pool of its own afterwards. Returns 0 on
+ * success.
+ */
+int linkedlist_compact(linkedlist_t *list);
+/* Forget the nodes and packed items the list remembers to speed up later
+ * calls, after code other than these functions has relinked its nodes.
+ * Returns 0 on success.
+ */
+int linkedlist_invalidate(linkedlist_t *list);
+/* Turn caching on (or off) for the list, which remembers nodes and packed items
+ * to speed up later calls but makes reading the list change the list struct.
+ * Lists do not cache by default. Turning it off frees the memory it keeps.
+ * Returns 0 on success.
+ */
+int linkedlist_cache(linkedlist_t *list, int on);
+
+#ifdef LINKEDLIST_STATS
+/* Copy the list's counters into stats. Returns 0 on success. */
+int linkedlist_stats_get(linkedlist_t *list, linkedlist_stats_t *stats);
+/* Set the list's counters to zero. Returns 0 on success. */
+int linkedlist_stats_reset(linkedlist_t *list);
+/* Call a function with the operation name, index and list size whenever a
+ * function walks walk nodes of a list (or never if f is null). Returns 0 on
+ * success.
+ */
+int linkedlist_stats_sethook(size_t walk, void (*f)(linkedlist_t *list,
+    const char *op, size_t index, size_t size));
+#endif
+
+#endif
@@ -0,0 +1,433 @@
+/*
+ * linkedlist_intrusive.c
+ * Version 20261018
+ * Written by Harry Wong (RedAndBlueEraser)
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "linkedlist_intrusive.h"
+
+static void linkedlist_intrusive_link(linkedlist_intrusive_t *list,
+    linkedlist_link_t *prev, linkedlist_link_t *link) {
+    /* Add link to list after prev (or at the start if prev is null). */
+    link->prev = prev;
+    link->next = prev ? prev->next : list->head;
+    if (link->next) {
+        link->next->prev = link;
+    } else {
+        list->foot = link;
+    }
+    if (prev) {
+        prev->next = link;
+    } else {
+        list->head = link;
+    }
+    list->size++;
+}
+
+static linkedlist_link_t *linkedlist_intrusive_at(linkedlist_intrusive_t *list,
+    size_t index) {
+    linkedlist_link_t *curr;
+    size_t i;
+
+    /* Walk from whichever end of the list is closer. */
+    if (index < list->size / 2) {
+        curr = list->head;
+        for (i = 0; i < index; i++) {
+            curr = curr->next;
+        }
+    } else {
+        curr = list->foot;
+        for (i = list->size - 1; i > index; i--) {
+            curr = curr->prev;
+        }
+    }
+    return curr;
+}
+
+static void linkedlist_intrusive_clear(linkedlist_link_t *curr) {
+    linkedlist_link_t *next;
+
+    /* Unlink a chain of links from each other. */
+    while (curr) {
+        next = curr->next;
+        curr->next = curr->prev = NULL;
+        curr = next;
+    }
+}
+
+
+int linkedlist_intrusive_create(linkedlist_intrusive_t *list) {
+    list->head = list->foot = NULL;
+    list->size = 0;
+    return 0;
+}
+
+int linkedlist_intrusive_destroy(linkedlist_intrusive_t *list) {
+    linkedlist_intrusive_clear(list->head);
+    return linkedlist_intrusive_create(list);
+}
+
+
+size_t linkedlist_intrusive_size(linkedlist_intrusive_t *list) {
+    return list->size;
+}
+
+int linkedlist_intrusive_isempty(linkedlist_intrusive_t *list) {
+    return list->size == 0;
+}
+
+
+int linkedlist_intrusive_push(linkedlist_intrusive_t *list,
+    linkedlist_link_t *link) {
+    linkedlist_intrusive_link(list, list->foot, link);
+    return 0;
+}
+
+linkedlist_link_t *linkedlist_intrusive_pop(linkedlist_intrusive_t *list) {
+    linkedlist_link_t *foot = list->foot;
+
+    /* Cannot pop empty list. */
+    if (list->size == 0) {
+        fprintf(stderr, "List is empty\n");
+        return NULL;
+    }
+
+    linkedlist_intrusive_unlink(list, foot);
+    return foot;
+}
+
+int linkedlist_intrusive_unshift(linkedlist_intrusive_t *list,
+    linkedlist_link_t *link) {
+    linkedlist_intrusive_link(list, NULL, link);
+    return 0;
+}
+
+linkedlist_link_t *linkedlist_intrusive_shift(linkedlist_intrusive_t *list) {
+    linkedlist_link_t *head = list->head;
+
+    /* Cannot shift empty list. */
+    if (list->size == 0) {
+        fprintf(stderr, "List is empty\n");
+        return NULL;
+    }
+
+    linkedlist_intrusive_unlink(list, head);
+    return head;
+}
+
+int linkedlist_intrusive_add(linkedlist_intrusive_t *list, size_t index,
+    linkedlist_link_t *link) {
+    /* Cannot add to index out of range. */
+    if (index > list->size) {
+        fprintf(stderr, "List out of range\n");
+        return 1;
+    }
+
+    /* Add link after the link before the specified position. */
+    if (index == list->size) {
+        linkedlist_intrusive_link(list, list->foot, link);
+    } else {
+        linkedlist_intrusive_link(list,
+            linkedlist_intrusive_at(list, index)->prev, link);
+    }
+    return 0;
+}
+
+linkedlist_link_t *linkedlist_intrusive_remove(linkedlist_intrusive_t *list,
+    size_t index) {
+    linkedlist_link_t *link;
+
+    /* Cannot remove from index out of range. */
+    if (index >= list->size) {
+        fprintf(stderr, "List out of range\n");
+        return NULL;
+    }
+
+    link = linkedlist_intrusive_at(list, index);
+    linkedlist_intrusive_unlink(list, link);
+    return link;
+}
+
+int linkedlist_intrusive_unlink(linkedlist_intrusive_t *list,
+    linkedlist_link_t *link) {
+    /* Remove link from list. */
+    if (link->prev) {
+        link->prev->next = link->next;
+    } else {
+        list->head = link->next;
+    }
+    if (link->next) {
+        link->next->prev = link->prev;
+    } else {
+        list->foot = link->prev;
+    }
+    link->next = link->prev = NULL;
+    list->size--;
+    return 0;
+}
+
+int linkedlist_intrusive_concat(linkedlist_intrusive_t *dest,
+    linkedlist_intrusive_t *src) {
+    /* Link the src chain onto the end of dest. */
+    if (src->size == 0) {
+        return 0;
+    } else if (dest->size == 0) {
+        dest->head = src->head;
+    } else {
+        dest->foot->next = src->head;
+        src->head->prev = dest->foot;
+    }
+    dest->foot = src->foot;
+    dest->size += src->size;
+    return linkedlist_intrusive_create(src);
+}
+
+
+linkedlist_link_t *linkedlist_intrusive_get(linkedlist_intrusive_t *list,
+    size_t index) {
+    /* Cannot get index out of range. */
+    if (index >= list->size) {
+        fprintf(stderr, "List out of range\n");
+        return NULL;
+    }
+
+    return linkedlist_intrusive_at(list, index);
+}
+
+linkedlist_link_t *linkedlist_intrusive_first(linkedlist_intrusive_t *list) {
+    /* Cannot get from empty list. */
+    if (list->size == 0) {
+        fprintf(stderr, "List is empty\n");
+        return NULL;
+    }
+
+    return list->head;
+}
+
+linkedlist_link_t *linkedlist_intrusive_last(linkedlist_intrusive_t *list) {
+    /* Cannot get from empty list. */
+    if (list->size == 0) {
+        fprintf(stderr, "List is empty\n");
+        return NULL;
+    }
+
+    return list->foot;
+}
+
+size_t linkedlist_intrusive_indexof(linkedlist_intrusive_t *list,
+    linkedlist_link_t *link) {
+    linkedlist_link_t *curr;
+    size_t i = 0;
+
+    /* Iterate until item is found or the end of the list. */
+    for (curr = list->head; curr && curr != link; curr = curr->next) {
+        i++;
+    }
+    return i;
+}
+
+linkedlist_link_t *linkedlist_intrusive_find(linkedlist_intrusive_t *list,
+    int (*f)(linkedlist_link_t *)) {
+    linkedlist_link_t *curr;
+
+    /* Test each item until an item passes the test. */
+    for (curr = list->head; curr; curr = curr->next) {
+        if (f(curr) == 1) {
+            return curr;
+        }
+    }
+    return NULL;
+}
+
+size_t linkedlist_intrusive_findindex(linkedlist_intrusive_t *list,
+    int (*f)(linkedlist_link_t *)) {
+    linkedlist_link_t *curr;
+    size_t i = 0;
+
+    /* Test each item until an item passes the test. */
+    for (curr = list->head; curr && f(curr) != 1; curr = curr->next) {
+        i++;
+    }
+    return i;
+}
+
+int linkedlist_intrusive_foreach(linkedlist_intrusive_t *list,
+    void (*f)(linkedlist_link_t *)) {
+    linkedlist_link_t *curr, *next;
+
+    /* Read the next link first so that f may unlink the current one. */
+    for (curr = list->head; curr; curr = next) {
+        next = curr->next;
+        f(curr);
+    }
+    return 0;
+}
+
+int linkedlist_intrusive_foreachreverse(linkedlist_intrusive_t *list,
+    void (*f)(linkedlist_link_t *)) {
+    linkedlist_link_t *curr, *prev;
+
+    /* Read the previous link first so that f may unlink the current one. */
+    for (curr = list->foot; curr; curr = prev) {
+        prev = curr->prev;
+        f(curr);
+    }
+    return 0;
+}
+
+
+int linkedlist_intrusive_slice(linkedlist_intrusive_t *list, size_t start,
+    size_t end) {
+    linkedlist_link_t *head, *foot;
+
+    /* Slice to empty list. */
+    if (start >= end || start >= list->size) {
+        return linkedlist_intrusive_destroy(list);
+    }
+    /* Slice to end of list. */
+    if (end > list->size) {
+        end = list->size;
+    }
+
+    /* Find the new list head and foot. */
+    head = linkedlist_intrusive_at(list, start);
+    foot = linkedlist_intrusive_at(list, end - 1);
+
+    /* Unlink the links before head and after foot. */
+    if (head->prev) {
+        head->prev->next = NULL;
+        linkedlist_intrusive_clear(list->head);
+    }
+    linkedlist_intrusive_clear(foot->next);
+    head->prev = foot->next = NULL;
+    list->head = head;
+    list->foot = foot;
+    list->size = end - start;
+    return 0;
+}
+
+int linkedlist_intrusive_split(linkedlist_intrusive_t *src, size_t index,
+    linkedlist_intrusive_t *dest) {
+    linkedlist_link_t *link;
+
+    /* Cannot split from index beyond list size. */
+    if (index > src->size) {
+        fprintf(stderr, "List out of range\n");
+        return 1;
+    }
+
+    linkedlist_intrusive_create(dest);
+    if (index == src->size) {
+        return 0;
+    }
+
+    /* Move links from index onwards to dest. */
+    link = linkedlist_intrusive_at(src, index);
+    dest->head = link;
+    dest->foot = src->foot;
+    dest->size = src->size - index;
+    if (index == 0) {
+        linkedlist_intrusive_create(src);
+    } else {
+        src->foot = link->prev;
+        src->foot->next = NULL;
+        src->size = index;
+    }
+    link->prev = NULL;
+    return 0;
+}
+
+int linkedlist_intrusive_reverse(linkedlist_intrusive_t *list) {
+    linkedlist_link_t *curr = list->head, *next;
+
+    /* Swap the next and prev pointers of every link. */
+    while (curr) {
+        next = curr->next;
+        curr->next = curr->prev;
+        curr->prev = next;
+        curr = next;
+    }
+    curr = list->head;
+    list->head = list->foot;
+    list->foot = curr;
+    return 0;
+}
+
+static linkedlist_link_t *linkedlist_intrusive_merge(linkedlist_link_t *a,
+    linkedlist_link_t *b,
+    int (*f)(const linkedlist_link_t *, const linkedlist_link_t *)) {
+    linkedlist_link_t head, *tail = &head;
+
+    /* Merge two sorted chains, taking from a first on ties to stay stable. */
+    while (a && b) {
+        if (f(a, b) <= 0) {
+            tail->next = a;
+            a = a->next;
+        } else {
+            tail->next = b;
+            b = b->next;
+        }
+        tail = tail->next;
+    }
+    tail->next = a ? a : b;
+    return head.next;
+}
+
+int linkedlist_intrusive_sort(linkedlist_intrusive_t *list,
+    int (*f)(const linkedlist_link_t *, const linkedlist_link_t *)) {
+    linkedlist_link_t *runs[sizeof(size_t) * 8] = { NULL };
+    linkedlist_link_t *curr = list->head, *run, *last, *next, *prev;
+    size_t i, nruns = 0;
+
+    /* Split the list into sorted runs and merge runs of similar lengths. */
+    while (curr) {
+        run = last = curr;
+        curr = curr->next;
+        if (curr && f(curr, last) < 0) {
+            /* Reverse a strictly descending run while it is being found. */
+            run->next = NULL;
+            while (curr && f(curr, run) < 0) {
+                next = curr->next;
+                curr->next = run;
+                run = curr;
+                curr = next;
+            }
+        } else {
+            /* Extend an ascending run. */
+            while (curr && f(curr, last) >= 0) {
+                last = curr;
+                curr = curr->next;
+            }
+            last->next = NULL;
+        }
+
+        for (i = 0; runs[i]; i++) {
+            run = linkedlist_intrusive_merge(runs[i], run, f);
+            runs[i] = NULL;
+        }
+        runs[i] = run;
+        if (i >= nruns) {
+            nruns = i + 1;
+        }
+    }
+
+    /* Merge the remaining runs, earlier items being in later runs. */
+    run = NULL;
+    for (i = 0; i < nruns; i++) {
+        if (runs[i]) {
+            run = run ? linkedlist_intrusive_merge(runs[i], run, f) : runs[i];
+        }
+    }
+
+    /* Relink prev pointers and assign new list head and foot. */
+    list->head = run;
+    prev = NULL;
+    for (curr = run; curr; curr = curr->next) {
+        curr->prev = prev;
+        prev = curr;
+    }
+    list->foot = prev;
+    return 0;
+}
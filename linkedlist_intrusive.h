@@ -0,0 +1,116 @@
+/*
+ * linkedlist_intrusive.h
+ * Version 20261018
+ * Written by Harry Wong (RedAndBlueEraser)
+ */
+
+#ifndef LINKEDLIST_INTRUSIVE_H
+#define LINKEDLIST_INTRUSIVE_H
+
+#include <stddef.h>
+
+/* Get a pointer to the struct of the specified type which contains the link as
+ * the specified member.
+ */
+#define LINKEDLIST_CONTAINER(link, type, member) \
+    ((type *)((char *)(link) - offsetof(type, member)))
+
+typedef struct linkedlist_link_t {
+    struct linkedlist_link_t *next;
+    struct linkedlist_link_t *prev;
+} linkedlist_link_t;
+
+typedef struct linkedlist_intrusive_t {
+    linkedlist_link_t *head;
+    linkedlist_link_t *foot;
+    size_t size;
+} linkedlist_intrusive_t;
+
+/* Create a new empty list. Returns 0 on success. */
+int linkedlist_intrusive_create(linkedlist_intrusive_t *list);
+/* Unlink every item from the list. Returns 0 on success. */
+int linkedlist_intrusive_destroy(linkedlist_intrusive_t *list);
+
+/* Get and return the number of items in the list. */
+size_t linkedlist_intrusive_size(linkedlist_intrusive_t *list);
+/* Check if list contains no items. */
+int linkedlist_intrusive_isempty(linkedlist_intrusive_t *list);
+
+/* Add an item to the end of the list. Returns 0 on success. */
+int linkedlist_intrusive_push(linkedlist_intrusive_t *list,
+    linkedlist_link_t *link);
+/* Remove and return the item on the end of the list. */
+linkedlist_link_t *linkedlist_intrusive_pop(linkedlist_intrusive_t *list);
+/* Add an item to the start of the list. Returns 0 on success. */
+int linkedlist_intrusive_unshift(linkedlist_intrusive_t *list,
+    linkedlist_link_t *link);
+/* Remove and return the item on the start of the list. */
+linkedlist_link_t *linkedlist_intrusive_shift(linkedlist_intrusive_t *list);
+/* Add an item to the specified position in the list. Returns 0 on success. */
+int linkedlist_intrusive_add(linkedlist_intrusive_t *list, size_t index,
+    linkedlist_link_t *link);
+/* Remove and return the item in the specified position of the list. */
+linkedlist_link_t *linkedlist_intrusive_remove(linkedlist_intrusive_t *list,
+    size_t index);
+/* Remove an item which is in the list. Returns 0 on success. */
+int linkedlist_intrusive_unlink(linkedlist_intrusive_t *list,
+    linkedlist_link_t *link);
+/* Move the items from the src list to the end of the dest list, leaving src
+ * empty. Returns 0 on success.
+ */
+int linkedlist_intrusive_concat(linkedlist_intrusive_t *dest,
+    linkedlist_intrusive_t *src);
+
+/* Get and return the item in the specified position in the list. */
+linkedlist_link_t *linkedlist_intrusive_get(linkedlist_intrusive_t *list,
+    size_t index);
+/* Get and return the first item in the list. */
+linkedlist_link_t *linkedlist_intrusive_first(linkedlist_intrusive_t *list);
+/* Get and return the last item in the list. */
+linkedlist_link_t *linkedlist_intrusive_last(linkedlist_intrusive_t *list);
+/* Find and return the index of the specified item in the list. Returns the
+ * number of items in the list if the item is not found.
+ */
+size_t linkedlist_intrusive_indexof(linkedlist_intrusive_t *list,
+    linkedlist_link_t *link);
+/* Find and return the first item in the list that pass the test (provided as a
+ * function where a pass is 1). Returns null if no items pass the test.
+ */
+linkedlist_link_t *linkedlist_intrusive_find(linkedlist_intrusive_t *list,
+    int (*f)(linkedlist_link_t *));
+/* Find and return the index of the first item in the list that pass the test
+ * (provided as a function where a pass is 1). Returns the number of items in
+ * the list if no items pass the test.
+ */
+size_t linkedlist_intrusive_findindex(linkedlist_intrusive_t *list,
+    int (*f)(linkedlist_link_t *));
+/* Iterate over the list and execute a function on each item. Returns 0 on
+ * success.
+ */
+int linkedlist_intrusive_foreach(linkedlist_intrusive_t *list,
+    void (*f)(linkedlist_link_t *));
+/* Iterate over the list from the end and execute a function on each item.
+ * Returns 0 on success.
+ */
+int linkedlist_intrusive_foreachreverse(linkedlist_intrusive_t *list,
+    void (*f)(linkedlist_link_t *));
+
+/* Slice the list from including start to excluding end, unlinking the other
+ * items. Returns 0 on success.
+ */
+int linkedlist_intrusive_slice(linkedlist_intrusive_t *list, size_t start,
+    size_t end);
+/* Move the items from the specified position onwards in the src list to a new
+ * dest list. Returns 0 on success.
+ */
+int linkedlist_intrusive_split(linkedlist_intrusive_t *src, size_t index,
+    linkedlist_intrusive_t *dest);
+/* Reverse the order of items in the list. Returns 0 on success. */
+int linkedlist_intrusive_reverse(linkedlist_intrusive_t *list);
+/* Sort the items in the list, keeping the order of equal items. Returns 0 on
+ * success.
+ */
+int linkedlist_intrusive_sort(linkedlist_intrusive_t *list,
+    int (*f)(const linkedlist_link_t *, const linkedlist_link_t *));
+
+#endif
@@ -0,0 +1,378 @@
+/*
+ * linkedlist_packed.c
+ * Version 20261018
+ * Written by Harry Wong (RedAndBlueEraser)
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "linkedlist_packed.h"
+
+#define NONE LINKEDLIST_PACKED_NONE
+
+/* Number of nodes the array starts with, doubling whenever it is full. */
+#ifndef LINKEDLIST_PACKED_CAPACITY
+#define LINKEDLIST_PACKED_CAPACITY 64
+#endif
+
+static int linkedlist_packed_grow(linkedlist_packed_t *list, size_t count) {
+    linkedlist_packed_node_t *nodes;
+    size_t capacity = list->capacity ? list->capacity
+        : LINKEDLIST_PACKED_CAPACITY;
+
+    /* Cannot hold more nodes than indices can link to. */
+    if (count >= NONE) {
+        fprintf(stderr, "List is full\n");
+        return 1;
+    }
+    if (count <= list->capacity) {
+        return 0;
+    }
+
+    /* Double the array until it holds count nodes, keeping every index. */
+    while (capacity < count) {
+        capacity *= 2;
+    }
+    if (capacity >= NONE) {
+        capacity = NONE - 1;
+    }
+    nodes = (linkedlist_packed_node_t*)realloc(list->nodes,
+        capacity * sizeof *nodes);
+    if (!nodes) {
+        fprintf(stderr, "Out of memory\n");
+        return 1;
+    }
+    list->nodes = nodes;
+    list->capacity = (uint32_t)capacity;
+    return 0;
+}
+
+static uint32_t linkedlist_packed_node_alloc(linkedlist_packed_t *list) {
+    uint32_t node;
+
+    /* Reuse a freed node, or carve the next unused node of the array. */
+    if (list->free != NONE) {
+        node = list->free;
+        list->free = list->nodes[node].next;
+        return node;
+    }
+    if (list->carved == list->capacity
+        && linkedlist_packed_grow(list, (size_t)list->carved + 1)) {
+        return NONE;
+    }
+    return list->carved++;
+}
+
+static void linkedlist_packed_node_free(linkedlist_packed_t *list,
+    uint32_t node) {
+    /* Return node to the free list. */
+    list->nodes[node].next = list->free;
+    list->free = node;
+}
+
+static void linkedlist_packed_link(linkedlist_packed_t *list, uint32_t prev,
+    uint32_t node) {
+    linkedlist_packed_node_t *nodes = list->nodes;
+
+    /* Add node to list after prev (or at the start if prev is none). */
+    nodes[node].prev = prev;
+    nodes[node].next = prev != NONE ? nodes[prev].next : list->head;
+    if (nodes[node].next != NONE) {
+        nodes[nodes[node].next].prev = node;
+    } else {
+        list->foot = node;
+    }
+    if (prev != NONE) {
+        nodes[prev].next = node;
+    } else {
+        list->head = node;
+    }
+    list->size++;
+}
+
+static linkedlist_packed_value_t linkedlist_packed_unlink(
+    linkedlist_packed_t *list, uint32_t node) {
+    linkedlist_packed_node_t *nodes = list->nodes;
+
+    /* Remove node from list and free it. */
+    if (nodes[node].prev != NONE) {
+        nodes[nodes[node].prev].next = nodes[node].next;
+    } else {
+        list->head = nodes[node].next;
+    }
+    if (nodes[node].next != NONE) {
+        nodes[nodes[node].next].prev = nodes[node].prev;
+    } else {
+        list->foot = nodes[node].prev;
+    }
+    linkedlist_packed_node_free(list, node);
+    list->size--;
+    return nodes[node].data;
+}
+
+static uint32_t linkedlist_packed_at(linkedlist_packed_t *list, size_t index) {
+    uint32_t curr;
+    size_t i;
+
+    /* Walk from whichever end of the list is closer. */
+    if (index < list->size / 2) {
+        curr = list->head;
+        for (i = 0; i < index; i++) {
+            curr = list->nodes[curr].next;
+        }
+    } else {
+        curr = list->foot;
+        for (i = list->size - 1; i > index; i--) {
+            curr = list->nodes[curr].prev;
+        }
+    }
+    return curr;
+}
+
+
+int linkedlist_packed_create(linkedlist_packed_t *list) {
+    list->nodes = NULL;
+    list->capacity = list->carved = 0;
+    list->free = list->head = list->foot = NONE;
+    list->size = 0;
+    return 0;
+}
+
+int linkedlist_packed_destroy(linkedlist_packed_t *list) {
+    free(list->nodes);
+    return linkedlist_packed_create(list);
+}
+
+int linkedlist_packed_clone(linkedlist_packed_t *src,
+    linkedlist_packed_t *dest) {
+    /* Copy every node at once, keeping their indices. */
+    linkedlist_packed_create(dest);
+    if (src->carved == 0) {
+        return 0;
+    }
+    dest->nodes = (linkedlist_packed_node_t*)malloc(src->carved
+        * sizeof *dest->nodes);
+    if (!dest->nodes) {
+        fprintf(stderr, "Out of memory\n");
+        return 1;
+    }
+    memcpy(dest->nodes, src->nodes, src->carved * sizeof *dest->nodes);
+    dest->capacity = dest->carved = src->carved;
+    dest->free = src->free;
+    dest->head = src->head;
+    dest->foot = src->foot;
+    dest->size = src->size;
+    return 0;
+}
+
+int linkedlist_packed_reserve(linkedlist_packed_t *list, size_t count) {
+    return linkedlist_packed_grow(list, count);
+}
+
+
+size_t linkedlist_packed_size(linkedlist_packed_t *list) {
+    return list->size;
+}
+
+int linkedlist_packed_isempty(linkedlist_packed_t *list) {
+    return list->size == 0;
+}
+
+
+int linkedlist_packed_push(linkedlist_packed_t *list,
+    linkedlist_packed_value_t data) {
+    uint32_t node = linkedlist_packed_node_alloc(list);
+    if (node == NONE) {
+        return 1;
+    }
+
+    list->nodes[node].data = data;
+    linkedlist_packed_link(list, list->foot, node);
+    return 0;
+}
+
+linkedlist_packed_value_t linkedlist_packed_pop(linkedlist_packed_t *list) {
+    linkedlist_packed_value_t data;
+
+    /* Cannot pop empty list. */
+    if (list->size == 0) {
+        fprintf(stderr, "List is empty\n");
+        memset(&data, 0, sizeof data);
+        return data;
+    }
+
+    return linkedlist_packed_unlink(list, list->foot);
+}
+
+int linkedlist_packed_unshift(linkedlist_packed_t *list,
+    linkedlist_packed_value_t data) {
+    uint32_t node = linkedlist_packed_node_alloc(list);
+    if (node == NONE) {
+        return 1;
+    }
+
+    list->nodes[node].data = data;
+    linkedlist_packed_link(list, NONE, node);
+    return 0;
+}
+
+linkedlist_packed_value_t linkedlist_packed_shift(linkedlist_packed_t *list) {
+    linkedlist_packed_value_t data;
+
+    /* Cannot shift empty list. */
+    if (list->size == 0) {
+        fprintf(stderr, "List is empty\n");
+        memset(&data, 0, sizeof data);
+        return data;
+    }
+
+    return linkedlist_packed_unlink(list, list->head);
+}
+
+int linkedlist_packed_add(linkedlist_packed_t *list, size_t index,
+    linkedlist_packed_value_t data) {
+    uint32_t node;
+
+    /* Cannot add to index beyond list size. */
+    if (index > list->size) {
+        fprintf(stderr, "List out of range\n");
+        return 1;
+    }
+
+    node = linkedlist_packed_node_alloc(list);
+    if (node == NONE) {
+        return 1;
+    }
+    list->nodes[node].data = data;
+
+    /* Add node after the node before the specified position. */
+    if (index == list->size) {
+        linkedlist_packed_link(list, list->foot, node);
+    } else {
+        linkedlist_packed_link(list,
+            list->nodes[linkedlist_packed_at(list, index)].prev, node);
+    }
+    return 0;
+}
+
+linkedlist_packed_value_t linkedlist_packed_remove(linkedlist_packed_t *list,
+    size_t index) {
+    linkedlist_packed_value_t data;
+
+    /* Cannot remove from index beyond list size. */
+    if (index >= list->size) {
+        fprintf(stderr, "List out of range\n");
+        memset(&data, 0, sizeof data);
+        return data;
+    }
+
+    return linkedlist_packed_unlink(list, linkedlist_packed_at(list, index));
+}
+
+int linkedlist_packed_set(linkedlist_packed_t *list, size_t index,
+    linkedlist_packed_value_t data) {
+    /* Cannot set index beyond list size. */
+    if (index >= list->size) {
+        fprintf(stderr, "List out of range\n");
+        return 1;
+    }
+
+    list->nodes[linkedlist_packed_at(list, index)].data = data;
+    return 0;
+}
+
+
+linkedlist_packed_value_t linkedlist_packed_get(linkedlist_packed_t *list,
+    size_t index) {
+    linkedlist_packed_value_t data;
+
+    /* Cannot get index beyond list size. */
+    if (index >= list->size) {
+        fprintf(stderr, "List out of range\n");
+        memset(&data, 0, sizeof data);
+        return data;
+    }
+
+    return list->nodes[linkedlist_packed_at(list, index)].data;
+}
+
+linkedlist_packed_value_t linkedlist_packed_first(linkedlist_packed_t *list) {
+    linkedlist_packed_value_t data;
+
+    /* Cannot get from empty list. */
+    if (list->size == 0) {
+        fprintf(stderr, "List is empty\n");
+        memset(&data, 0, sizeof data);
+        return data;
+    }
+
+    return list->nodes[list->head].data;
+}
+
+linkedlist_packed_value_t linkedlist_packed_last(linkedlist_packed_t *list) {
+    linkedlist_packed_value_t data;
+
+    /* Cannot get from empty list. */
+    if (list->size == 0) {
+        fprintf(stderr, "List is empty\n");
+        memset(&data, 0, sizeof data);
+        return data;
+    }
+
+    return list->nodes[list->foot].data;
+}
+
+size_t linkedlist_packed_indexof(linkedlist_packed_t *list,
+    linkedlist_packed_value_t data) {
+    linkedlist_packed_node_t *nodes = list->nodes;
+    uint32_t curr;
+    size_t i = 0;
+
+    /* Iterate until item is found or the end of the list. */
+    for (curr = list->head; curr != NONE && nodes[curr].data != data;
+        curr = nodes[curr].next) {
+        i++;
+    }
+    return i;
+}
+
+size_t linkedlist_packed_findindex(linkedlist_packed_t *list,
+    int (*f)(linkedlist_packed_value_t)) {
+    linkedlist_packed_node_t *nodes = list->nodes;
+    uint32_t curr;
+    size_t i = 0;
+
+    /* Test each item until an item passes the test. */
+    for (curr = list->head; curr != NONE && f(nodes[curr].data) != 1;
+        curr = nodes[curr].next) {
+        i++;
+    }
+    return i;
+}
+
+int linkedlist_packed_foreach(linkedlist_packed_t *list,
+    void (*f)(linkedlist_packed_value_t)) {
+    linkedlist_packed_node_t *nodes = list->nodes;
+    uint32_t curr;
+
+    /* Execute function on every item. */
+    for (curr = list->head; curr != NONE; curr = nodes[curr].next) {
+        f(nodes[curr].data);
+    }
+    return 0;
+}
+
+
+int linkedlist_packed_toarray(linkedlist_packed_t *src,
+    linkedlist_packed_value_t dest[]) {
+    linkedlist_packed_node_t *nodes = src->nodes;
+    uint32_t curr;
+    size_t i = 0;
+
+    /* Copies each item from the list to the array. */
+    for (curr = src->head; curr != NONE; curr = nodes[curr].next) {
+        dest[i++] = nodes[curr].data;
+    }
+    return 0;
+}
@@ -0,0 +1,110 @@
+/*
+ * linkedlist_packed.h
+ * Version 20261018
+ * Written by Harry Wong (RedAndBlueEraser)
+ */
+
+#ifndef LINKEDLIST_PACKED_H
+#define LINKEDLIST_PACKED_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* Type of items stored in the nodes. Define as uint32_t (or another small
+ * type) when compiling every file which includes this header to store
+ * integers in place of pointers.
+ */
+#ifndef LINKEDLIST_PACKED_VALUE
+#define LINKEDLIST_PACKED_VALUE void *
+#endif
+
+/* Index which links to no node. */
+#define LINKEDLIST_PACKED_NONE UINT32_MAX
+
+typedef LINKEDLIST_PACKED_VALUE linkedlist_packed_value_t;
+
+typedef struct linkedlist_packed_node_t {
+    uint32_t next;
+    uint32_t prev;
+    linkedlist_packed_value_t data;
+} linkedlist_packed_node_t;
+
+typedef struct linkedlist_packed_t {
+    linkedlist_packed_node_t *nodes;
+    uint32_t capacity;
+    uint32_t carved;
+    uint32_t free;
+    uint32_t head;
+    uint32_t foot;
+    size_t size;
+} linkedlist_packed_t;
+
+/* Create a new empty list. Returns 0 on success. */
+int linkedlist_packed_create(linkedlist_packed_t *list);
+/* Empty the list and free its nodes. Returns 0 on success. */
+int linkedlist_packed_destroy(linkedlist_packed_t *list);
+/* Copies a list. Returns 0 on success. */
+int linkedlist_packed_clone(linkedlist_packed_t *src,
+    linkedlist_packed_t *dest);
+/* Make room for the list to hold count items without growing. Returns 0 on
+ * success.
+ */
+int linkedlist_packed_reserve(linkedlist_packed_t *list, size_t count);
+
+/* Get and return the number of items in the list. */
+size_t linkedlist_packed_size(linkedlist_packed_t *list);
+/* Check if list contains no items. */
+int linkedlist_packed_isempty(linkedlist_packed_t *list);
+
+/* Add an item to the end of the list. Returns 0 on success. */
+int linkedlist_packed_push(linkedlist_packed_t *list,
+    linkedlist_packed_value_t data);
+/* Remove and return the item on the end of the list. */
+linkedlist_packed_value_t linkedlist_packed_pop(linkedlist_packed_t *list);
+/* Add an item to the start of the list. Returns 0 on success. */
+int linkedlist_packed_unshift(linkedlist_packed_t *list,
+    linkedlist_packed_value_t data);
+/* Remove and return the item on the start of the list. */
+linkedlist_packed_value_t linkedlist_packed_shift(linkedlist_packed_t *list);
+/* Add an item to the specified position in the list. Returns 0 on success. */
+int linkedlist_packed_add(linkedlist_packed_t *list, size_t index,
+    linkedlist_packed_value_t data);
+/* Remove and return the item in the specified position of the list. */
+linkedlist_packed_value_t linkedlist_packed_remove(linkedlist_packed_t *list,
+    size_t index);
+/* Replace an item in the specified position of the list. Returns 0 on success.
+ */
+int linkedlist_packed_set(linkedlist_packed_t *list, size_t index,
+    linkedlist_packed_value_t data);
+
+/* Get and return the item in the specified position in the list. */
+linkedlist_packed_value_t linkedlist_packed_get(linkedlist_packed_t *list,
+    size_t index);
+/* Get and return the first item in the list. */
+linkedlist_packed_value_t linkedlist_packed_first(linkedlist_packed_t *list);
+/* Get and return the last item in the list. */
+linkedlist_packed_value_t linkedlist_packed_last(linkedlist_packed_t *list);
+/* Find and return the index of the specified item in the list. Returns the
+ * number of items in the list if the item is not found.
+ */
+size_t linkedlist_packed_indexof(linkedlist_packed_t *list,
+    linkedlist_packed_value_t data);
+/* Find and return the index of the first item in the list that pass the test
+ * (provided as a function where a pass is 1). Returns the number of items in
+ * the list if no items pass the test.
+ */
+size_t linkedlist_packed_findindex(linkedlist_packed_t *list,
+    int (*f)(linkedlist_packed_value_t));
+/* Iterate over the list and execute a function on each item. Returns 0 on
+ * success.
+ */
+int linkedlist_packed_foreach(linkedlist_packed_t *list,
+    void (*f)(linkedlist_packed_value_t));
+
+/* Copy the items of the list to an array of at least size items. Returns 0 on
+ * success.
+ */
+int linkedlist_packed_toarray(linkedlist_packed_t *src,
+    linkedlist_packed_value_t dest[]);
+
+#endif
@@ -0,0 +1,420 @@
+/*
+ * linkedlist_parallel.c
+ * Version 20261018
+ * Written by Harry Wong (RedAndBlueEraser)
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#include "linkedlist_parallel.h"
+
+#define SEGMENTS LINKEDLIST_PARALLEL_SEGMENTS
+
+typedef struct linkedlist_segments_t {
+    linkedlist_node_t **checkpoints;
+    size_t count;
+    size_t stride;
+    linkedlist_node_t *local[SEGMENTS];
+} linkedlist_segments_t;
+
+typedef struct linkedlist_parallel_t {
+    linkedlist_segments_t segments;
+    void (*foreach)(void *);
+    int (*test)(void *);
+    atomic_size_t next;
+    atomic_size_t found;
+    void *data;
+    pthread_mutex_t mutex;
+} linkedlist_parallel_t;
+
+typedef struct linkedlist_parallelsort_t {
+    linkedlist_t *parts;
+    size_t count;
+    size_t step;
+    int (*f)(const void *, const void *);
+    atomic_size_t next;
+} linkedlist_parallelsort_t;
+
+static void *linkedlist_workers_main(void *arg) {
+    linkedlist_workers_t *workers = (linkedlist_workers_t*)arg;
+    void (*job)(void *);
+    size_t generation = 0;
+
+    pthread_mutex_lock(&workers->mutex);
+    for (;;) {
+        /* Wait for a new job. */
+        while (!workers->stopping && workers->generation == generation) {
+            pthread_cond_wait(&workers->start, &workers->mutex);
+        }
+        if (workers->stopping) {
+            break;
+        }
+        generation = workers->generation;
+        job = workers->job;
+        arg = workers->arg;
+
+        /* Run job and report back. */
+        pthread_mutex_unlock(&workers->mutex);
+        job(arg);
+        pthread_mutex_lock(&workers->mutex);
+        if (--workers->running == 0) {
+            pthread_cond_broadcast(&workers->done);
+        }
+    }
+    pthread_mutex_unlock(&workers->mutex);
+    return NULL;
+}
+
+static void linkedlist_workers_run(linkedlist_workers_t *workers,
+    void (*job)(void *), void *arg) {
+    /* Hand job to every worker once they are idle. */
+    pthread_mutex_lock(&workers->mutex);
+    while (workers->running > 0) {
+        pthread_cond_wait(&workers->done, &workers->mutex);
+    }
+    workers->job = job;
+    workers->arg = arg;
+    workers->generation++;
+    workers->running = workers->count;
+    pthread_cond_broadcast(&workers->start);
+    pthread_mutex_unlock(&workers->mutex);
+
+    /* Run job on this thread too and wait for the workers to finish. */
+    job(arg);
+    pthread_mutex_lock(&workers->mutex);
+    while (workers->running > 0) {
+        pthread_cond_wait(&workers->done, &workers->mutex);
+    }
+    pthread_mutex_unlock(&workers->mutex);
+}
+
+int linkedlist_workers_create(linkedlist_workers_t *workers, size_t count) {
+    size_t i;
+
+    /* Initialise pool attributes. */
+    workers->threads = (pthread_t*)malloc(count * sizeof *workers->threads);
+    if (count > 0 && !workers->threads) {
+        fprintf(stderr, "Out of memory\n");
+        return 1;
+    }
+    workers->count = 0;
+    workers->job = NULL;
+    workers->arg = NULL;
+    workers->generation = 0;
+    workers->running = 0;
+    workers->stopping = 0;
+    pthread_mutex_init(&workers->mutex, NULL);
+    pthread_cond_init(&workers->start, NULL);
+    pthread_cond_init(&workers->done, NULL);
+
+    /* Start worker threads. */
+    for (i = 0; i < count; i++) {
+        if (pthread_create(&workers->threads[i], NULL, linkedlist_workers_main,
+            workers)) {
+            fprintf(stderr, "Cannot create thread\n");
+            linkedlist_workers_destroy(workers);
+            return 1;
+        }
+        workers->count++;
+    }
+    return 0;
+}
+
+int linkedlist_workers_destroy(linkedlist_workers_t *workers) {
+    size_t i;
+
+    /* Wake and join worker threads. */
+    pthread_mutex_lock(&workers->mutex);
+    workers->stopping = 1;
+    pthread_cond_broadcast(&workers->start);
+    pthread_mutex_unlock(&workers->mutex);
+    for (i = 0; i < workers->count; i++) {
+        pthread_join(workers->threads[i], NULL);
+    }
+
+    /* Free memory allocated for the pool. */
+    free(workers->threads);
+    workers->threads = NULL;
+    workers->count = 0;
+    pthread_cond_destroy(&workers->done);
+    pthread_cond_destroy(&workers->start);
+    pthread_mutex_destroy(&workers->mutex);
+    return 0;
+}
+
+
+static size_t linkedlist_parallel_split(linkedlist_t *list,
+    linkedlist_node_t **checkpoints, size_t *stride) {
+    linkedlist_node_t *curr;
+    size_t count = 0, i;
+
+    /* Find every node a segment starts at, with a stride to fit the whole
+     * list.
+     */
+    *stride = (list->size + SEGMENTS - 1) / SEGMENTS;
+    for (curr = list->head, i = 0; curr; curr = curr->next, i++) {
+        if (i % *stride == 0) {
+            checkpoints[count++] = curr;
+        }
+    }
+    return count;
+}
+
+static int linkedlist_parallel_checkpoint(linkedlist_t *list) {
+    linkedlist_node_t *curr, *last;
+    size_t i;
+
+    /* Keep the checkpoints until pushes have grown the last segment past
+     * twice the stride.
+     */
+    if (list->checkpointcount > 0 && list->size - (list->checkpointcount - 1)
+        * list->checkpointstride <= 2 * list->checkpointstride) {
+        return 0;
+    }
+    last = list->checkpointcount > 0
+        ? list->checkpoints[list->checkpointcount - 1] : NULL;
+    if (!list->checkpoints) {
+        list->checkpoints = (linkedlist_node_t**)malloc(
+            SEGMENTS * sizeof *list->checkpoints);
+        if (!list->checkpoints) {
+            fprintf(stderr, "Out of memory\n");
+            return 1;
+        }
+    }
+
+    /* Add checkpoints after the last one while there is room. */
+    if (last) {
+        curr = last->next;
+        for (i = 1; curr && list->checkpointcount < SEGMENTS; i++) {
+            if (i % list->checkpointstride == 0) {
+                list->checkpoints[list->checkpointcount++] = curr;
+            }
+            curr = curr->next;
+        }
+        if (list->size - (list->checkpointcount - 1) * list->checkpointstride
+            <= 2 * list->checkpointstride) {
+            return 0;
+        }
+    }
+
+    /* Otherwise remember the segments of the whole list again. */
+    list->checkpointcount = linkedlist_parallel_split(list, list->checkpoints,
+        &list->checkpointstride);
+    return 0;
+}
+
+static int linkedlist_parallel_segments(linkedlist_t *list,
+    linkedlist_segments_t *segments) {
+    /* Find the segments on every call unless the list caches checkpoints, so
+     * that the list struct is left unchanged.
+     */
+    if (!list->cache) {
+        segments->checkpoints = segments->local;
+        segments->count = linkedlist_parallel_split(list, segments->local,
+            &segments->stride);
+        return 0;
+    }
+    if (linkedlist_parallel_checkpoint(list)) {
+        return 1;
+    }
+    segments->checkpoints = list->checkpoints;
+    segments->count = list->checkpointcount;
+    segments->stride = list->checkpointstride;
+    return 0;
+}
+
+static void linkedlist_parallel_job(void *arg) {
+    linkedlist_parallel_t *parallel = (linkedlist_parallel_t*)arg;
+    linkedlist_segments_t *segments = &parallel->segments;
+    linkedlist_node_t *curr, *end;
+    size_t segment, index;
+
+    /* Claim segments in order until none are left. */
+    while ((segment = atomic_fetch_add_explicit(&parallel->next, 1,
+        memory_order_relaxed)) < segments->count) {
+        curr = segments->checkpoints[segment];
+        end = segment + 1 < segments->count
+            ? segments->checkpoints[segment + 1] : NULL;
+        index = segment * segments->stride;
+
+        for (; curr != end; curr = curr->next, index++) {
+            if (parallel->foreach) {
+                parallel->foreach(curr->data);
+                continue;
+            }
+
+            /* Give up once an earlier item has passed the test. */
+            if (index > atomic_load_explicit(&parallel->found,
+                memory_order_relaxed)) {
+                return;
+            }
+            if (parallel->test(curr->data) == 1) {
+                pthread_mutex_lock(&parallel->mutex);
+                if (index < atomic_load_explicit(&parallel->found,
+                    memory_order_relaxed)) {
+                    atomic_store_explicit(&parallel->found, index,
+                        memory_order_relaxed);
+                    parallel->data = curr->data;
+                }
+                pthread_mutex_unlock(&parallel->mutex);
+                break;
+            }
+        }
+    }
+}
+
+static int linkedlist_parallel_run(linkedlist_t *list,
+    linkedlist_workers_t *workers, linkedlist_parallel_t *parallel) {
+    if (list->size == 0) {
+        return 0;
+    }
+    if (linkedlist_parallel_segments(list, &parallel->segments)) {
+        return 1;
+    }
+
+    /* Share the segments between the workers. */
+    atomic_init(&parallel->next, 0);
+    pthread_mutex_init(&parallel->mutex, NULL);
+    linkedlist_workers_run(workers, linkedlist_parallel_job, parallel);
+    pthread_mutex_destroy(&parallel->mutex);
+    return 0;
+}
+
+int linkedlist_foreachparallel(linkedlist_t *list,
+    linkedlist_workers_t *workers, void (*f)(void *)) {
+    linkedlist_parallel_t parallel;
+
+    parallel.foreach = f;
+    parallel.test = NULL;
+    return linkedlist_parallel_run(list, workers, &parallel);
+}
+
+void *linkedlist_findparallel(linkedlist_t *list,
+    linkedlist_workers_t *workers, int (*f)(void *)) {
+    linkedlist_parallel_t parallel;
+
+    parallel.foreach = NULL;
+    parallel.test = f;
+    atomic_init(&parallel.found, SIZE_MAX);
+    parallel.data = NULL;
+    linkedlist_parallel_run(list, workers, &parallel);
+    return parallel.data;
+}
+
+size_t linkedlist_findindexparallel(linkedlist_t *list,
+    linkedlist_workers_t *workers, int (*f)(void *)) {
+    linkedlist_parallel_t parallel;
+
+    parallel.foreach = NULL;
+    parallel.test = f;
+    atomic_init(&parallel.found, SIZE_MAX);
+    parallel.data = NULL;
+    linkedlist_parallel_run(list, workers, &parallel);
+    return atomic_load(&parallel.found) == SIZE_MAX ? list->size
+        : atomic_load(&parallel.found);
+}
+
+
+static void linkedlist_parallel_merge(linkedlist_t *a, linkedlist_t *b,
+    int (*f)(const void *, const void *)) {
+    linkedlist_node_t head, *tail = &head, *x = a->head, *y = b->head;
+
+    /* Merge b into a, taking from a first on ties to stay stable. */
+    while (x && y) {
+        if (f(&x->data, &y->data) <= 0) {
+            tail->next = x;
+            x = x->next;
+        } else {
+            tail->next = y;
+            y = y->next;
+        }
+        tail->next->prev = tail;
+        tail = tail->next;
+    }
+    tail->next = x ? x : y;
+    tail->next->prev = tail;
+    a->head = head.next;
+    a->head->prev = NULL;
+    if (!x) {
+        a->foot = b->foot;
+    }
+    a->size += b->size;
+}
+
+static void linkedlist_parallel_sortjob(void *arg) {
+    linkedlist_parallelsort_t *sort = (linkedlist_parallelsort_t*)arg;
+    size_t span = sort->step ? 2 * sort->step : 1, i;
+
+    /* Claim parts in order until none are left, sorting each part on the
+     * first round and merging it with the part step parts on after that.
+     */
+    while ((i = atomic_fetch_add_explicit(&sort->next, 1,
+        memory_order_relaxed) * span) < sort->count) {
+        if (sort->step == 0) {
+            linkedlist_sort(&sort->parts[i], sort->f);
+        } else if (i + sort->step < sort->count) {
+            linkedlist_parallel_merge(&sort->parts[i],
+                &sort->parts[i + sort->step], sort->f);
+        }
+    }
+}
+
+int linkedlist_sortparallel(linkedlist_t *list, linkedlist_workers_t *workers,
+    int (*f)(const void *, const void *)) {
+    linkedlist_parallelsort_t sort;
+    linkedlist_segments_t segments;
+    linkedlist_t *part;
+    size_t i;
+
+    /* Sort short lists on this thread alone. */
+    if (list->size < LINKEDLIST_PARALLEL_SORT || workers->count == 0) {
+        return linkedlist_sort(list, f);
+    }
+    if (linkedlist_parallel_segments(list, &segments)) {
+        return 1;
+    }
+    sort.count = segments.count;
+    sort.parts = (linkedlist_t*)malloc(sort.count * sizeof *sort.parts);
+    if (!sort.parts) {
+        fprintf(stderr, "Out of memory\n");
+        return 1;
+    }
+
+    /* Cut the list into parts at the checkpoints. */
+    for (i = 0; i < sort.count; i++) {
+        part = &sort.parts[i];
+        linkedlist_create(part);
+        part->head = segments.checkpoints[i];
+        if (i + 1 < sort.count) {
+            part->foot = segments.checkpoints[i + 1]->prev;
+            part->size = segments.stride;
+        } else {
+            part->foot = list->foot;
+            part->size = list->size - i * segments.stride;
+        }
+    }
+    for (i = 0; i < sort.count; i++) {
+        sort.parts[i].head->prev = NULL;
+        sort.parts[i].foot->next = NULL;
+    }
+
+    /* Sort every part, then merge neighbouring parts in rounds until one part
+     * holds the whole list.
+     */
+    sort.f = f;
+    sort.step = 0;
+    do {
+        atomic_store_explicit(&sort.next, 0, memory_order_relaxed);
+        linkedlist_workers_run(workers, linkedlist_parallel_sortjob, &sort);
+        sort.step = sort.step ? sort.step * 2 : 1;
+    } while (sort.step < sort.count);
+
+    /* Assign new list head and foot, and forget the relinked nodes. */
+    list->head = sort.parts[0].head;
+    list->foot = sort.parts[0].foot;
+    linkedlist_invalidate(list);
+    free(sort.parts);
+    return 0;
+}
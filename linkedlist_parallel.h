@@ -0,0 +1,66 @@
+/*
+ * linkedlist_parallel.h
+ * Version 20261018
+ * Written by Harry Wong (RedAndBlueEraser)
+ */
+
+#ifndef LINKEDLIST_PARALLEL_H
+#define LINKEDLIST_PARALLEL_H
+
+#include <pthread.h>
+#include <stddef.h>
+#include "linkedlist.h"
+
+/* Number of segments lists are split into for workers to share. */
+#ifndef LINKEDLIST_PARALLEL_SEGMENTS
+#define LINKEDLIST_PARALLEL_SEGMENTS 64
+#endif
+
+/* Fewest items in a list sorted by several threads. */
+#ifndef LINKEDLIST_PARALLEL_SORT
+#define LINKEDLIST_PARALLEL_SORT 65536
+#endif
+
+typedef struct linkedlist_workers_t {
+    pthread_t *threads;
+    size_t count;
+    pthread_mutex_t mutex;
+    pthread_cond_t start;
+    pthread_cond_t done;
+    void (*job)(void *);
+    void *arg;
+    size_t generation;
+    size_t running;
+    int stopping;
+} linkedlist_workers_t;
+
+/* Create a pool of count worker threads. Returns 0 on success. */
+int linkedlist_workers_create(linkedlist_workers_t *workers, size_t count);
+/* Stop and join the worker threads. Returns 0 on success. */
+int linkedlist_workers_destroy(linkedlist_workers_t *workers);
+
+/* Execute a function on each item of the list, sharing the items between the
+ * workers and the calling thread. Returns 0 on success.
+ */
+int linkedlist_foreachparallel(linkedlist_t *list,
+    linkedlist_workers_t *workers, void (*f)(void *));
+/* Find and return the first item in the list that pass the test (provided as a
+ * function where a pass is 1), sharing the items between the workers and the
+ * calling thread. Returns null if no items pass the test.
+ */
+void *linkedlist_findparallel(linkedlist_t *list,
+    linkedlist_workers_t *workers, int (*f)(void *));
+/* Find and return the index of the first item in the list that pass the test
+ * (provided as a function where a pass is 1), sharing the items between the
+ * workers and the calling thread. Returns the number of items in the list if
+ * no items pass the test.
+ */
+size_t linkedlist_findindexparallel(linkedlist_t *list,
+    linkedlist_workers_t *workers, int (*f)(void *));
+/* Sort the items in the list, keeping the order of equal items, sharing the
+ * items between the workers and the calling thread. Returns 0 on success.
+ */
+int linkedlist_sortparallel(linkedlist_t *list, linkedlist_workers_t *workers,
+    int (*f)(const void *, const void *));
+
+#endif
@@ -0,0 +1,385 @@
+/*
+ * linkedlist_persistent.c
+ * Version 20261018
+ * Written by Harry Wong (RedAndBlueEraser)
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "linkedlist_persistent.h"
+
+/*
+ * Nodes are counted by the lists and nodes which point to them, and a node is
+ * only changed in place while its count is 1 and every node before it in the
+ * list also has a count of 1. Lists keep their foot only while none of their
+ * nodes are shared. Cloning forgets the foot of src as well as dest, which is
+ * atomic so that threads may clone the same list at once.
+ */
+
+#define FOOT(list) atomic_load_explicit(&(list)->foot, memory_order_relaxed)
+#define SETFOOT(list, node) \
+    atomic_store_explicit(&(list)->foot, node, memory_order_relaxed)
+
+static linkedlist_persistent_node_t *linkedlist_persistent_node_alloc(
+    linkedlist_persistent_node_t *next, void *data) {
+    linkedlist_persistent_node_t *node;
+
+    node = (linkedlist_persistent_node_t*)malloc(sizeof *node);
+    if (!node) {
+        fprintf(stderr, "Out of memory\n");
+        return NULL;
+    }
+    node->next = next;
+    node->data = data;
+    atomic_init(&node->refs, 1);
+    return node;
+}
+
+static void linkedlist_persistent_hold(linkedlist_persistent_node_t *node) {
+    if (node) {
+        atomic_fetch_add_explicit(&node->refs, 1, memory_order_relaxed);
+    }
+}
+
+static void linkedlist_persistent_release(linkedlist_persistent_node_t *node) {
+    linkedlist_persistent_node_t *next;
+
+    /* Free nodes until one is still shared by another list. */
+    while (node && atomic_fetch_sub_explicit(&node->refs, 1,
+        memory_order_acq_rel) == 1) {
+        next = node->next;
+        free(node);
+        node = next;
+    }
+}
+
+static int linkedlist_persistent_own(linkedlist_persistent_t *list,
+    size_t count, linkedlist_persistent_node_t **prev) {
+    linkedlist_persistent_node_t **slot = &list->head, *node, *copy;
+    size_t i;
+
+    /* Copy the first count nodes where they are shared, and get the last of
+     * them (or null if count is 0).
+     */
+    *prev = NULL;
+    for (i = 0; i < count; i++) {
+        node = *slot;
+        if (atomic_load_explicit(&node->refs, memory_order_acquire) > 1) {
+            copy = linkedlist_persistent_node_alloc(node->next, node->data);
+            if (!copy) {
+                return 1;
+            }
+            linkedlist_persistent_hold(node->next);
+            *slot = copy;
+            linkedlist_persistent_release(node);
+            node = copy;
+        }
+        *prev = node;
+        slot = &node->next;
+    }
+    return 0;
+}
+
+static void *linkedlist_persistent_unlink(linkedlist_persistent_node_t **slot) {
+    linkedlist_persistent_node_t *node = *slot;
+    void *data = node->data;
+
+    /* Point past node, which is freed unless another list shares it. */
+    *slot = node->next;
+    linkedlist_persistent_hold(node->next);
+    linkedlist_persistent_release(node);
+    return data;
+}
+
+static linkedlist_persistent_node_t *linkedlist_persistent_at(
+    linkedlist_persistent_t *list, size_t index) {
+    linkedlist_persistent_node_t *curr = list->head;
+
+    /* Iterate until index. */
+    while (index-- > 0) {
+        curr = curr->next;
+    }
+    return curr;
+}
+
+
+int linkedlist_persistent_create(linkedlist_persistent_t *list) {
+    list->head = NULL;
+    SETFOOT(list, NULL);
+    list->size = 0;
+    return 0;
+}
+
+int linkedlist_persistent_destroy(linkedlist_persistent_t *list) {
+    linkedlist_persistent_release(list->head);
+    return linkedlist_persistent_create(list);
+}
+
+int linkedlist_persistent_clone(linkedlist_persistent_t *src,
+    linkedlist_persistent_t *dest) {
+    /* Share src's nodes, which neither list may change in place now. */
+    linkedlist_persistent_hold(src->head);
+    dest->head = src->head;
+    dest->size = src->size;
+    SETFOOT(dest, NULL);
+    if (FOOT(src)) {
+        SETFOOT(src, NULL);
+    }
+    return 0;
+}
+
+
+size_t linkedlist_persistent_size(linkedlist_persistent_t *list) {
+    return list->size;
+}
+
+int linkedlist_persistent_isempty(linkedlist_persistent_t *list) {
+    return list->size == 0;
+}
+
+
+int linkedlist_persistent_push(linkedlist_persistent_t *list, void *data) {
+    linkedlist_persistent_node_t *node, *prev = FOOT(list);
+
+    /* Copy every shared node, after which no nodes are shared. */
+    if (!prev && linkedlist_persistent_own(list, list->size, &prev)) {
+        return 1;
+    }
+    node = linkedlist_persistent_node_alloc(NULL, data);
+    if (!node) {
+        return 1;
+    }
+
+    /* Add node to list. */
+    if (prev) {
+        prev->next = node;
+    } else {
+        list->head = node;
+    }
+    SETFOOT(list, node);
+    list->size++;
+    return 0;
+}
+
+void *linkedlist_persistent_pop(linkedlist_persistent_t *list) {
+    linkedlist_persistent_node_t *prev;
+    void *data;
+
+    /* Cannot pop empty list. */
+    if (list->size == 0) {
+        fprintf(stderr, "List is empty\n");
+        return NULL;
+    }
+
+    /* Copy every shared node before the foot, then remove the foot. */
+    if (linkedlist_persistent_own(list, list->size - 1, &prev)) {
+        return NULL;
+    }
+    data = linkedlist_persistent_unlink(prev ? &prev->next : &list->head);
+    SETFOOT(list, prev);
+    list->size--;
+    return data;
+}
+
+int linkedlist_persistent_unshift(linkedlist_persistent_t *list, void *data) {
+    linkedlist_persistent_node_t *node;
+
+    /* The new node takes over the list's count of the old head. */
+    node = linkedlist_persistent_node_alloc(list->head, data);
+    if (!node) {
+        return 1;
+    }
+    list->head = node;
+    if (list->size == 0) {
+        SETFOOT(list, node);
+    }
+    list->size++;
+    return 0;
+}
+
+void *linkedlist_persistent_shift(linkedlist_persistent_t *list) {
+    void *data;
+
+    /* Cannot shift empty list. */
+    if (list->size == 0) {
+        fprintf(stderr, "List is empty\n");
+        return NULL;
+    }
+
+    data = linkedlist_persistent_unlink(&list->head);
+    list->size--;
+    if (list->size == 0) {
+        SETFOOT(list, NULL);
+    }
+    return data;
+}
+
+int linkedlist_persistent_add(linkedlist_persistent_t *list, size_t index,
+    void *data) {
+    linkedlist_persistent_node_t *node, *prev;
+
+    /* Cannot add to index beyond list size. */
+    if (index > list->size) {
+        fprintf(stderr, "List out of range\n");
+        return 1;
+    }
+
+    /* Add to either end of the list. */
+    if (index == 0) {
+        return linkedlist_persistent_unshift(list, data);
+    } else if (index == list->size) {
+        return linkedlist_persistent_push(list, data);
+    }
+
+    /* Copy the shared nodes before index, then link node in after them. */
+    if (linkedlist_persistent_own(list, index, &prev)) {
+        return 1;
+    }
+    node = linkedlist_persistent_node_alloc(prev->next, data);
+    if (!node) {
+        return 1;
+    }
+    prev->next = node;
+    list->size++;
+    return 0;
+}
+
+void *linkedlist_persistent_remove(linkedlist_persistent_t *list,
+    size_t index) {
+    linkedlist_persistent_node_t *prev;
+    void *data;
+
+    /* Cannot remove from index beyond list size. */
+    if (index >= list->size) {
+        fprintf(stderr, "List out of range\n");
+        return NULL;
+    }
+
+    /* Remove from either end of the list. */
+    if (index == 0) {
+        return linkedlist_persistent_shift(list);
+    } else if (index == list->size - 1) {
+        return linkedlist_persistent_pop(list);
+    }
+
+    /* Copy the shared nodes before index, then remove the node after them. */
+    if (linkedlist_persistent_own(list, index, &prev)) {
+        return NULL;
+    }
+    data = linkedlist_persistent_unlink(&prev->next);
+    list->size--;
+    return data;
+}
+
+int linkedlist_persistent_set(linkedlist_persistent_t *list, size_t index,
+    void *data) {
+    linkedlist_persistent_node_t *node;
+
+    /* Cannot set index beyond list size. */
+    if (index >= list->size) {
+        fprintf(stderr, "List out of range\n");
+        return 1;
+    }
+
+    /* Copy the shared nodes up to index, then change the node at index. */
+    if (linkedlist_persistent_own(list, index + 1, &node)) {
+        return 1;
+    }
+    node->data = data;
+    return 0;
+}
+
+
+void *linkedlist_persistent_get(linkedlist_persistent_t *list, size_t index) {
+    /* Cannot get index beyond list size. */
+    if (index >= list->size) {
+        fprintf(stderr, "List out of range\n");
+        return NULL;
+    }
+
+    return linkedlist_persistent_at(list, index)->data;
+}
+
+void *linkedlist_persistent_first(linkedlist_persistent_t *list) {
+    /* Cannot get from empty list. */
+    if (list->size == 0) {
+        fprintf(stderr, "List is empty\n");
+        return NULL;
+    }
+
+    return list->head->data;
+}
+
+void *linkedlist_persistent_last(linkedlist_persistent_t *list) {
+    /* Cannot get from empty list. */
+    if (list->size == 0) {
+        fprintf(stderr, "List is empty\n");
+        return NULL;
+    }
+
+    if (FOOT(list)) {
+        return FOOT(list)->data;
+    }
+    return linkedlist_persistent_at(list, list->size - 1)->data;
+}
+
+size_t linkedlist_persistent_indexof(linkedlist_persistent_t *list,
+    void *data) {
+    linkedlist_persistent_node_t *curr;
+    size_t i = 0;
+
+    /* Iterate until item is found or the end of the list. */
+    for (curr = list->head; curr && curr->data != data; curr = curr->next) {
+        i++;
+    }
+    return i;
+}
+
+void *linkedlist_persistent_find(linkedlist_persistent_t *list,
+    int (*f)(void *)) {
+    linkedlist_persistent_node_t *curr;
+
+    /* Test each item until an item passes the test. */
+    for (curr = list->head; curr; curr = curr->next) {
+        if (f(curr->data) == 1) {
+            return curr->data;
+        }
+    }
+    return NULL;
+}
+
+size_t linkedlist_persistent_findindex(linkedlist_persistent_t *list,
+    int (*f)(void *)) {
+    linkedlist_persistent_node_t *curr;
+    size_t i = 0;
+
+    /* Iterate until an item passes the test or the end of the list. */
+    for (curr = list->head; curr && f(curr->data) != 1; curr = curr->next) {
+        i++;
+    }
+    return i;
+}
+
+int linkedlist_persistent_foreach(linkedlist_persistent_t *list,
+    void (*f)(void *)) {
+    linkedlist_persistent_node_t *curr;
+
+    /* Execute function on every item. */
+    for (curr = list->head; curr; curr = curr->next) {
+        f(curr->data);
+    }
+    return 0;
+}
+
+
+int linkedlist_persistent_toarray(linkedlist_persistent_t *src, void *dest[]) {
+    linkedlist_persistent_node_t *curr;
+    size_t i = 0;
+
+    /* Copies each item from the list to the array. */
+    for (curr = src->head; curr; curr = curr->next) {
+        dest[i++] = curr->data;
+    }
+    dest[i] = NULL;
+    return 0;
+}
@@ -0,0 +1,88 @@
+/*
+ * linkedlist_persistent.h
+ * Version 20261018
+ * Written by Harry Wong (RedAndBlueEraser)
+ */
+
+#ifndef LINKEDLIST_PERSISTENT_H
+#define LINKEDLIST_PERSISTENT_H
+
+#include <stdatomic.h>
+#include <stddef.h>
+
+typedef struct linkedlist_persistent_node_t {
+    struct linkedlist_persistent_node_t *next;
+    void *data;
+    atomic_size_t refs;
+} linkedlist_persistent_node_t;
+
+typedef struct linkedlist_persistent_t {
+    linkedlist_persistent_node_t *head;
+    _Atomic(linkedlist_persistent_node_t *) foot;
+    size_t size;
+} linkedlist_persistent_t;
+
+/* Create a new empty list. Returns 0 on success. */
+int linkedlist_persistent_create(linkedlist_persistent_t *list);
+/* Empty the list, freeing nodes no other list shares. Returns 0 on success. */
+int linkedlist_persistent_destroy(linkedlist_persistent_t *list);
+/* Copies a list, sharing all of its nodes. Returns 0 on success. */
+int linkedlist_persistent_clone(linkedlist_persistent_t *src,
+    linkedlist_persistent_t *dest);
+
+/* Get and return the number of items in the list. */
+size_t linkedlist_persistent_size(linkedlist_persistent_t *list);
+/* Check if list contains no items. */
+int linkedlist_persistent_isempty(linkedlist_persistent_t *list);
+
+/* Add an item to the end of the list. Returns 0 on success. */
+int linkedlist_persistent_push(linkedlist_persistent_t *list, void *data);
+/* Remove and return the item on the end of the list. */
+void *linkedlist_persistent_pop(linkedlist_persistent_t *list);
+/* Add an item to the start of the list. Returns 0 on success. */
+int linkedlist_persistent_unshift(linkedlist_persistent_t *list, void *data);
+/* Remove and return the item on the start of the list. */
+void *linkedlist_persistent_shift(linkedlist_persistent_t *list);
+/* Add an item to the specified position in the list. Returns 0 on success. */
+int linkedlist_persistent_add(linkedlist_persistent_t *list, size_t index,
+    void *data);
+/* Remove and return the item in the specified position of the list. */
+void *linkedlist_persistent_remove(linkedlist_persistent_t *list,
+    size_t index);
+/* Replace an item in the specified position of the list. Returns 0 on success.
+ */
+int linkedlist_persistent_set(linkedlist_persistent_t *list, size_t index,
+    void *data);
+
+/* Get and return the item in the specified position in the list. */
+void *linkedlist_persistent_get(linkedlist_persistent_t *list, size_t index);
+/* Get and return the first item in the list. */
+void *linkedlist_persistent_first(linkedlist_persistent_t *list);
+/* Get and return the last item in the list. */
+void *linkedlist_persistent_last(linkedlist_persistent_t *list);
+/* Find and return the index of the specified item in the list. Returns the
+ * number of items in the list if the item is not found.
+ */
+size_t linkedlist_persistent_indexof(linkedlist_persistent_t *list,
+    void *data);
+/* Find and return the first item in the list that pass the test (provided as a
+ * function where a pass is 1). Returns null if no items pass the test.
+ */
+void *linkedlist_persistent_find(linkedlist_persistent_t *list,
+    int (*f)(void *));
+/* Find and return the index of the first item in the list that pass the test
+ * (provided as a function where a pass is 1). Returns the number of items in
+ * the list if no items pass the test.
+ */
+size_t linkedlist_persistent_findindex(linkedlist_persistent_t *list,
+    int (*f)(void *));
+/* Iterate over the list and execute a function on each item. Returns 0 on
+ * success.
+ */
+int linkedlist_persistent_foreach(linkedlist_persistent_t *list,
+    void (*f)(void *));
+
+/* Represents the list as a null-terminated array. Returns 0 on success. */
+int linkedlist_persistent_toarray(linkedlist_persistent_t *src, void *dest[]);
+
+#endif
@@ -0,0 +1,144 @@
+/*
+ * linkedlist_query.c
+ * Version 20261018
+ * Written by Harry Wong (RedAndBlueEraser)
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "linkedlist_query.h"
+
+typedef struct linkedlist_reduce_t {
+    void (*f)(void *, void *);
+    void *acc;
+} linkedlist_reduce_t;
+
+static int linkedlist_query_add(linkedlist_query_t *query,
+    linkedlist_stagekind_t kind, int (*filter)(void *), void *(*map)(void *),
+    size_t count) {
+    linkedlist_stage_t *stage;
+
+    /* Cannot add more stages than the query holds. */
+    if (query->count == LINKEDLIST_QUERY_STAGES) {
+        fprintf(stderr, "Query is full\n");
+        return 1;
+    }
+
+    stage = &query->stages[query->count++];
+    stage->kind = kind;
+    stage->filter = filter;
+    stage->map = map;
+    stage->count = count;
+    return 0;
+}
+
+static int linkedlist_query_run(linkedlist_query_t *query,
+    int (*sink)(void *, void *), void *state) {
+    linkedlist_node_t *curr;
+    linkedlist_stage_t *stage;
+    size_t left[LINKEDLIST_QUERY_STAGES], i;
+    void *data;
+    int done = 0;
+
+    /* Count down the items each skip and take stage has left, ending at once
+     * if a take stage has none.
+     */
+    for (i = 0; i < query->count; i++) {
+        left[i] = query->stages[i].count;
+        if (query->stages[i].kind == LINKEDLIST_STAGE_TAKE && left[i] == 0) {
+            return 0;
+        }
+    }
+
+    /* Pass each item through every stage in one walk of the list, until an
+     * item is dropped or a take stage passes on its last item.
+     */
+    for (curr = query->list->head; curr && !done; curr = curr->next) {
+        data = curr->data;
+        for (i = 0; i < query->count; i++) {
+            stage = &query->stages[i];
+            if (stage->kind == LINKEDLIST_STAGE_FILTER) {
+                if (stage->filter(data) != 1) {
+                    break;
+                }
+            } else if (stage->kind == LINKEDLIST_STAGE_MAP) {
+                data = stage->map(data);
+            } else if (stage->kind == LINKEDLIST_STAGE_SKIP) {
+                if (left[i] > 0) {
+                    left[i]--;
+                    break;
+                }
+            } else if (--left[i] == 0) {
+                done = 1;
+            }
+        }
+        if (i == query->count && sink(state, data)) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static int linkedlist_query_foreachsink(void *state, void *data) {
+    void (**f)(void *) = (void (**)(void *))state;
+    (*f)(data);
+    return 0;
+}
+
+static int linkedlist_query_reducesink(void *state, void *data) {
+    linkedlist_reduce_t *reduce = (linkedlist_reduce_t*)state;
+    reduce->f(reduce->acc, data);
+    return 0;
+}
+
+static int linkedlist_query_collectsink(void *state, void *data) {
+    return linkedlist_push((linkedlist_t*)state, data);
+}
+
+
+int linkedlist_query_create(linkedlist_query_t *query, linkedlist_t *list) {
+    query->list = list;
+    query->count = 0;
+    return 0;
+}
+
+int linkedlist_query_filter(linkedlist_query_t *query, int (*f)(void *)) {
+    return linkedlist_query_add(query, LINKEDLIST_STAGE_FILTER, f, NULL, 0);
+}
+
+int linkedlist_query_map(linkedlist_query_t *query, void *(*f)(void *)) {
+    return linkedlist_query_add(query, LINKEDLIST_STAGE_MAP, NULL, f, 0);
+}
+
+int linkedlist_query_skip(linkedlist_query_t *query, size_t count) {
+    return linkedlist_query_add(query, LINKEDLIST_STAGE_SKIP, NULL, NULL,
+        count);
+}
+
+int linkedlist_query_take(linkedlist_query_t *query, size_t count) {
+    return linkedlist_query_add(query, LINKEDLIST_STAGE_TAKE, NULL, NULL,
+        count);
+}
+
+
+int linkedlist_query_foreach(linkedlist_query_t *query, void (*f)(void *)) {
+    return linkedlist_query_run(query, linkedlist_query_foreachsink, &f);
+}
+
+int linkedlist_query_reduce(linkedlist_query_t *query,
+    void (*f)(void *acc, void *data), void *acc) {
+    linkedlist_reduce_t reduce;
+
+    reduce.f = f;
+    reduce.acc = acc;
+    return linkedlist_query_run(query, linkedlist_query_reducesink, &reduce);
+}
+
+int linkedlist_query_collect(linkedlist_query_t *query, linkedlist_t *dest,
+    linkedlist_pool_t *pool) {
+    /* Create a new empty list for dest, keeping the items added before any
+     * failure.
+     */
+    linkedlist_createpooled(dest, pool);
+    return linkedlist_query_run(query, linkedlist_query_collectsink, dest);
+}
@@ -0,0 +1,75 @@
+/*
+ * linkedlist_query.h
+ * Version 20261018
+ * Written by Harry Wong (RedAndBlueEraser)
+ */
+
+#ifndef LINKEDLIST_QUERY_H
+#define LINKEDLIST_QUERY_H
+
+#include <stddef.h>
+#include "linkedlist.h"
+
+/* Most stages in a query. */
+#ifndef LINKEDLIST_QUERY_STAGES
+#define LINKEDLIST_QUERY_STAGES 16
+#endif
+
+typedef enum linkedlist_stagekind_t {
+    LINKEDLIST_STAGE_FILTER,
+    LINKEDLIST_STAGE_MAP,
+    LINKEDLIST_STAGE_SKIP,
+    LINKEDLIST_STAGE_TAKE
+} linkedlist_stagekind_t;
+
+typedef struct linkedlist_stage_t {
+    linkedlist_stagekind_t kind;
+    int (*filter)(void *);
+    void *(*map)(void *);
+    size_t count;
+} linkedlist_stage_t;
+
+typedef struct linkedlist_query_t {
+    linkedlist_t *list;
+    linkedlist_stage_t stages[LINKEDLIST_QUERY_STAGES];
+    size_t count;
+} linkedlist_query_t;
+
+/* Create a new query over the items of the list with no stages. Returns 0 on
+ * success.
+ */
+int linkedlist_query_create(linkedlist_query_t *query, linkedlist_t *list);
+/* Add a stage which passes on only the items that pass the test (provided as
+ * a function where a pass is 1). Returns 0 on success.
+ */
+int linkedlist_query_filter(linkedlist_query_t *query, int (*f)(void *));
+/* Add a stage which passes on the result of a function on each item. Returns
+ * 0 on success.
+ */
+int linkedlist_query_map(linkedlist_query_t *query, void *(*f)(void *));
+/* Add a stage which drops the first count items and passes on the rest.
+ * Returns 0 on success.
+ */
+int linkedlist_query_skip(linkedlist_query_t *query, size_t count);
+/* Add a stage which passes on the first count items and ends the query after
+ * them. Returns 0 on success.
+ */
+int linkedlist_query_take(linkedlist_query_t *query, size_t count);
+
+/* Run the query and execute a function on each resulting item. Returns 0 on
+ * success.
+ */
+int linkedlist_query_foreach(linkedlist_query_t *query, void (*f)(void *));
+/* Run the query and combine each resulting item into the accumulator with a
+ * function. Returns 0 on success.
+ */
+int linkedlist_query_reduce(linkedlist_query_t *query,
+    void (*f)(void *acc, void *data), void *acc);
+/* Run the query and add the resulting items to a new dest list, which
+ * allocates its nodes from the pool (or from a pool of its own if pool is
+ * null). Returns 0 on success.
+ */
+int linkedlist_query_collect(linkedlist_query_t *query, linkedlist_t *dest,
+    linkedlist_pool_t *pool);
+
+#endif
@@ -0,0 +1,277 @@
+/*
+ * linkedlist_queue.c
+ * Version 20261018
+ * Written by Harry Wong (RedAndBlueEraser)
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include "linkedlist_queue.h"
+
+#define MAXTHREADS LINKEDLIST_QUEUE_MAXTHREADS
+
+/* Number of retired nodes a thread collects before freeing those which no
+ * thread still points to.
+ */
+#define SCANTHRESHOLD (MAXTHREADS * 2 * 2)
+
+/*
+ * A Michael-Scott queue. The head is a dummy node whose next node holds the
+ * first item. Nodes removed from the queue are retired rather than freed, and
+ * only freed once no thread has published a hazard pointer to them.
+ */
+
+static _Thread_local size_t linkedlist_queue_hint;
+
+static linkedlist_queue_hazard_t *linkedlist_queue_acquire(
+    linkedlist_queue_t *queue) {
+    linkedlist_queue_hazard_t *hazard;
+    size_t i = linkedlist_queue_hint;
+    int expected;
+
+    /* Claim a free hazard record, starting from the one used last time. */
+    for (;;) {
+        hazard = &queue->hazards[i];
+        expected = 0;
+        if (!atomic_load_explicit(&hazard->active, memory_order_relaxed)
+            && atomic_compare_exchange_strong_explicit(&hazard->active,
+                &expected, 1, memory_order_acquire, memory_order_relaxed)) {
+            linkedlist_queue_hint = i;
+            return hazard;
+        }
+        i = (i + 1) % MAXTHREADS;
+    }
+}
+
+static void linkedlist_queue_release(linkedlist_queue_hazard_t *hazard) {
+    atomic_store(&hazard->pointers[0], NULL);
+    atomic_store(&hazard->pointers[1], NULL);
+    atomic_store_explicit(&hazard->active, 0, memory_order_release);
+}
+
+static int linkedlist_queue_compare(const void *a, const void *b) {
+    uintptr_t x = *(const uintptr_t*)a, y = *(const uintptr_t*)b;
+    return x < y ? -1 : x > y;
+}
+
+static void linkedlist_queue_scan(linkedlist_queue_t *queue,
+    linkedlist_queue_hazard_t *hazard) {
+    uintptr_t pointers[MAXTHREADS * 2], key;
+    linkedlist_queue_node_t *curr = hazard->retired, *next;
+    size_t i, count = 0;
+
+    /* Gather the hazard pointers of every thread. */
+    for (i = 0; i < MAXTHREADS * 2; i++) {
+        next = atomic_load(&queue->hazards[i / 2].pointers[i % 2]);
+        if (next) {
+            pointers[count++] = (uintptr_t)next;
+        }
+    }
+    qsort(pointers, count, sizeof pointers[0], linkedlist_queue_compare);
+
+    /* Free retired nodes which no thread points to and keep the rest. */
+    hazard->retired = NULL;
+    hazard->retiredcount = 0;
+    while (curr) {
+        next = curr->retired;
+        key = (uintptr_t)curr;
+        if (bsearch(&key, pointers, count, sizeof pointers[0],
+            linkedlist_queue_compare)) {
+            curr->retired = hazard->retired;
+            hazard->retired = curr;
+            hazard->retiredcount++;
+        } else {
+            free(curr);
+        }
+        curr = next;
+    }
+}
+
+static void linkedlist_queue_retire(linkedlist_queue_t *queue,
+    linkedlist_queue_hazard_t *hazard, linkedlist_queue_node_t *node) {
+    node->retired = hazard->retired;
+    hazard->retired = node;
+    if (++hazard->retiredcount >= SCANTHRESHOLD) {
+        linkedlist_queue_scan(queue, hazard);
+    }
+}
+
+static void linkedlist_queue_init(linkedlist_queue_t *queue,
+    linkedlist_queue_node_t *node) {
+    size_t i;
+
+    /* Initialise queue attributes with the dummy node (or none). */
+    atomic_init(&queue->head, node);
+    atomic_init(&queue->foot, node);
+    for (i = 0; i < MAXTHREADS; i++) {
+        atomic_init(&queue->hazards[i].active, 0);
+        atomic_init(&queue->hazards[i].pointers[0], NULL);
+        atomic_init(&queue->hazards[i].pointers[1], NULL);
+        atomic_init(&queue->hazards[i].pushed, 0);
+        atomic_init(&queue->hazards[i].shifted, 0);
+        queue->hazards[i].retired = NULL;
+        queue->hazards[i].retiredcount = 0;
+    }
+}
+
+
+int linkedlist_queue_create(linkedlist_queue_t *queue) {
+    linkedlist_queue_node_t *node = (linkedlist_queue_node_t*)malloc(
+        sizeof *node);
+    if (!node) {
+        fprintf(stderr, "Out of memory\n");
+        return 1;
+    }
+
+    atomic_init(&node->next, NULL);
+    node->data = NULL;
+    linkedlist_queue_init(queue, node);
+    return 0;
+}
+
+int linkedlist_queue_destroy(linkedlist_queue_t *queue) {
+    linkedlist_queue_node_t *curr, *next;
+    size_t i;
+
+    /* Free memory allocated for nodes in the queue, including the dummy. */
+    curr = atomic_load(&queue->head);
+    while (curr) {
+        next = atomic_load(&curr->next);
+        free(curr);
+        curr = next;
+    }
+
+    /* Free memory allocated for retired nodes. */
+    for (i = 0; i < MAXTHREADS; i++) {
+        curr = queue->hazards[i].retired;
+        while (curr) {
+            next = curr->retired;
+            free(curr);
+            curr = next;
+        }
+    }
+
+    /* Leave the queue without nodes until it is created again. */
+    linkedlist_queue_init(queue, NULL);
+    return 0;
+}
+
+
+size_t linkedlist_queue_size(linkedlist_queue_t *queue) {
+    size_t i, pushed = 0, shifted = 0;
+
+    /* Sum the counts of every thread. */
+    for (i = 0; i < MAXTHREADS; i++) {
+        pushed += atomic_load_explicit(&queue->hazards[i].pushed,
+            memory_order_relaxed);
+        shifted += atomic_load_explicit(&queue->hazards[i].shifted,
+            memory_order_relaxed);
+    }
+    return pushed > shifted ? pushed - shifted : 0;
+}
+
+int linkedlist_queue_isempty(linkedlist_queue_t *queue) {
+    linkedlist_queue_hazard_t *hazard = linkedlist_queue_acquire(queue);
+    linkedlist_queue_node_t *head;
+    int isempty;
+
+    /* Protect the dummy node while reading its next node. */
+    do {
+        head = atomic_load(&queue->head);
+        atomic_store(&hazard->pointers[0], head);
+    } while (head != atomic_load(&queue->head));
+    isempty = !atomic_load(&head->next);
+
+    linkedlist_queue_release(hazard);
+    return isempty;
+}
+
+
+int linkedlist_queue_push(linkedlist_queue_t *queue, void *data) {
+    linkedlist_queue_hazard_t *hazard;
+    linkedlist_queue_node_t *node, *foot, *next;
+
+    /* Create new node. */
+    node = (linkedlist_queue_node_t*)malloc(sizeof *node);
+    if (!node) {
+        fprintf(stderr, "Out of memory\n");
+        return 1;
+    }
+    atomic_init(&node->next, NULL);
+    node->data = data;
+
+    hazard = linkedlist_queue_acquire(queue);
+    for (;;) {
+        /* Protect the foot node. */
+        foot = atomic_load(&queue->foot);
+        atomic_store(&hazard->pointers[0], foot);
+        if (foot != atomic_load(&queue->foot)) {
+            continue;
+        }
+
+        /* Help a lagging foot along, or link node after the foot. */
+        next = atomic_load(&foot->next);
+        if (foot != atomic_load(&queue->foot)) {
+            continue;
+        }
+        if (next) {
+            atomic_compare_exchange_weak(&queue->foot, &foot, next);
+            continue;
+        }
+        if (atomic_compare_exchange_weak(&foot->next, &next, node)) {
+            atomic_compare_exchange_strong(&queue->foot, &foot, node);
+            break;
+        }
+    }
+
+    atomic_store_explicit(&hazard->pushed, atomic_load_explicit(
+        &hazard->pushed, memory_order_relaxed) + 1, memory_order_relaxed);
+    linkedlist_queue_release(hazard);
+    return 0;
+}
+
+void *linkedlist_queue_shift(linkedlist_queue_t *queue) {
+    linkedlist_queue_hazard_t *hazard = linkedlist_queue_acquire(queue);
+    linkedlist_queue_node_t *head, *foot, *next;
+    void *data;
+
+    for (;;) {
+        /* Protect the dummy node and the node after it. */
+        head = atomic_load(&queue->head);
+        atomic_store(&hazard->pointers[0], head);
+        if (head != atomic_load(&queue->head)) {
+            continue;
+        }
+        foot = atomic_load(&queue->foot);
+        next = atomic_load(&head->next);
+        atomic_store(&hazard->pointers[1], next);
+        if (head != atomic_load(&queue->head)) {
+            continue;
+        }
+
+        /* Cannot shift empty queue. */
+        if (!next) {
+            linkedlist_queue_release(hazard);
+            return NULL;
+        }
+
+        /* Help a lagging foot along, or make the next node the dummy node. */
+        if (head == foot) {
+            atomic_compare_exchange_weak(&queue->foot, &foot, next);
+            continue;
+        }
+        data = next->data;
+        if (atomic_compare_exchange_weak(&queue->head, &head, next)) {
+            break;
+        }
+    }
+
+    atomic_store_explicit(&hazard->shifted, atomic_load_explicit(
+        &hazard->shifted, memory_order_relaxed) + 1, memory_order_relaxed);
+    atomic_store(&hazard->pointers[0], NULL);
+    atomic_store(&hazard->pointers[1], NULL);
+    linkedlist_queue_retire(queue, hazard, head);
+    linkedlist_queue_release(hazard);
+    return data;
+}
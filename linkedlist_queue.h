@@ -0,0 +1,58 @@
+/*
+ * linkedlist_queue.h
+ * Version 20261018
+ * Written by Harry Wong (RedAndBlueEraser)
+ */
+
+#ifndef LINKEDLIST_QUEUE_H
+#define LINKEDLIST_QUEUE_H
+
+#include <stdatomic.h>
+#include <stddef.h>
+
+/* Maximum number of threads which can be inside queue functions at once. */
+#ifndef LINKEDLIST_QUEUE_MAXTHREADS
+#define LINKEDLIST_QUEUE_MAXTHREADS 128
+#endif
+
+typedef struct linkedlist_queue_node_t {
+    _Atomic(struct linkedlist_queue_node_t *) next;
+    void *data;
+    struct linkedlist_queue_node_t *retired;
+} linkedlist_queue_node_t;
+
+typedef struct linkedlist_queue_hazard_t {
+    _Alignas(64) atomic_int active;
+    _Atomic(linkedlist_queue_node_t *) pointers[2];
+    atomic_size_t pushed;
+    atomic_size_t shifted;
+    linkedlist_queue_node_t *retired;
+    size_t retiredcount;
+} linkedlist_queue_hazard_t;
+
+typedef struct linkedlist_queue_t {
+    _Alignas(64) _Atomic(linkedlist_queue_node_t *) head;
+    _Alignas(64) _Atomic(linkedlist_queue_node_t *) foot;
+    linkedlist_queue_hazard_t hazards[LINKEDLIST_QUEUE_MAXTHREADS];
+} linkedlist_queue_t;
+
+/* Create a new empty queue. Returns 0 on success. */
+int linkedlist_queue_create(linkedlist_queue_t *queue);
+/* Free the queue's memory, leaving it unusable until it is created again.
+ * Must not be called while other threads use the queue. Returns 0 on success.
+ */
+int linkedlist_queue_destroy(linkedlist_queue_t *queue);
+
+/* Get and return the number of items in the queue. */
+size_t linkedlist_queue_size(linkedlist_queue_t *queue);
+/* Check if queue contains no items. */
+int linkedlist_queue_isempty(linkedlist_queue_t *queue);
+
+/* Add an item to the end of the queue. Returns 0 on success. */
+int linkedlist_queue_push(linkedlist_queue_t *queue, void *data);
+/* Remove and return the item on the start of the queue. Returns null if the
+ * queue is empty.
+ */
+void *linkedlist_queue_shift(linkedlist_queue_t *queue);
+
+#endif
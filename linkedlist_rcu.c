@@ -0,0 +1,466 @@
+/*
+ * linkedlist_rcu.c
+ * Version 20261018
+ * Written by Harry Wong (RedAndBlueEraser)
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <sched.h>
+#include "linkedlist_rcu.h"
+
+/*
+ * Readers walk the list without locking, so writers never change a node that
+ * a reader can reach other than by storing a new next or data pointer. Writers
+ * take the mutex, link new nodes in with release stores, and retire unlinked
+ * nodes stamped with the epoch they were unlinked in. Each reader announces the
+ * epoch it entered in, and a retired node is freed once every reader inside a
+ * read function entered in a later epoch.
+ */
+
+static void linkedlist_rcu_enter(linkedlist_rcu_reader_t *reader) {
+    /* Announce the epoch before loading any node. */
+    atomic_store_explicit(&reader->epoch, atomic_load_explicit(
+        &reader->list->epoch, memory_order_acquire), memory_order_relaxed);
+    atomic_thread_fence(memory_order_seq_cst);
+}
+
+static void linkedlist_rcu_leave(linkedlist_rcu_reader_t *reader) {
+    atomic_store_explicit(&reader->epoch, 0, memory_order_release);
+}
+
+static void linkedlist_rcu_reclaim(linkedlist_rcu_t *list) {
+    linkedlist_rcu_reader_t *reader;
+    linkedlist_rcu_node_t *node;
+    size_t epoch, oldest = SIZE_MAX;
+
+    /* Find the oldest epoch a reader is still reading in. */
+    atomic_thread_fence(memory_order_seq_cst);
+    for (reader = list->readers; reader; reader = reader->next) {
+        epoch = atomic_load(&reader->epoch);
+        if (epoch && epoch < oldest) {
+            oldest = epoch;
+        }
+    }
+
+    /* Free retired nodes unlinked before then. */
+    while (list->retired && list->retired->epoch < oldest) {
+        node = list->retired;
+        list->retired = node->retired;
+        free(node);
+    }
+    if (!list->retired) {
+        list->retiredfoot = NULL;
+    }
+}
+
+static void linkedlist_rcu_retire(linkedlist_rcu_t *list,
+    linkedlist_rcu_node_t *node) {
+    /* Stamp node with the current epoch and start the next one. */
+    node->epoch = atomic_fetch_add(&list->epoch, 1);
+    node->retired = NULL;
+    if (list->retiredfoot) {
+        list->retiredfoot->retired = node;
+    } else {
+        list->retired = node;
+    }
+    list->retiredfoot = node;
+}
+
+static linkedlist_rcu_node_t *linkedlist_rcu_node_at(linkedlist_rcu_t *list,
+    size_t index) {
+    linkedlist_rcu_node_t *curr;
+    size_t size = atomic_load_explicit(&list->size, memory_order_relaxed), i;
+
+    /* Walk from whichever end of the list is closer. */
+    if (index < size / 2) {
+        curr = atomic_load_explicit(&list->head, memory_order_relaxed);
+        for (i = 0; i < index; i++) {
+            curr = atomic_load_explicit(&curr->next, memory_order_relaxed);
+        }
+    } else {
+        curr = list->foot;
+        for (i = size - 1; i > index; i--) {
+            curr = curr->prev;
+        }
+    }
+    return curr;
+}
+
+static int linkedlist_rcu_insert(linkedlist_rcu_t *list,
+    linkedlist_rcu_node_t *prev, void *data) {
+    linkedlist_rcu_node_t *node, *next;
+
+    /* Create new node. */
+    node = (linkedlist_rcu_node_t*)malloc(sizeof *node);
+    if (!node) {
+        fprintf(stderr, "Out of memory\n");
+        return 1;
+    }
+    next = prev ? atomic_load_explicit(&prev->next, memory_order_relaxed)
+        : atomic_load_explicit(&list->head, memory_order_relaxed);
+    atomic_init(&node->next, next);
+    atomic_init(&node->data, data);
+    node->prev = prev;
+
+    /* Publish node to readers once it is filled in. */
+    if (prev) {
+        atomic_store_explicit(&prev->next, node, memory_order_release);
+    } else {
+        atomic_store_explicit(&list->head, node, memory_order_release);
+    }
+    if (next) {
+        next->prev = node;
+    } else {
+        list->foot = node;
+    }
+    atomic_store_explicit(&list->size, atomic_load_explicit(&list->size,
+        memory_order_relaxed) + 1, memory_order_relaxed);
+    return 0;
+}
+
+static void *linkedlist_rcu_delete(linkedlist_rcu_t *list,
+    linkedlist_rcu_node_t *node) {
+    linkedlist_rcu_node_t *next = atomic_load_explicit(&node->next,
+        memory_order_relaxed);
+    void *data = atomic_load_explicit(&node->data, memory_order_relaxed);
+
+    /* Unlink node, leaving its next node for readers still on it. */
+    if (node->prev) {
+        atomic_store_explicit(&node->prev->next, next, memory_order_release);
+    } else {
+        atomic_store_explicit(&list->head, next, memory_order_release);
+    }
+    if (next) {
+        next->prev = node->prev;
+    } else {
+        list->foot = node->prev;
+    }
+    atomic_store_explicit(&list->size, atomic_load_explicit(&list->size,
+        memory_order_relaxed) - 1, memory_order_relaxed);
+
+    linkedlist_rcu_retire(list, node);
+    linkedlist_rcu_reclaim(list);
+    return data;
+}
+
+int linkedlist_rcu_create(linkedlist_rcu_t *list) {
+    /* Initialise list attributes. */
+    atomic_init(&list->head, NULL);
+    list->foot = NULL;
+    atomic_init(&list->size, 0);
+    atomic_init(&list->epoch, 1);
+    list->retired = NULL;
+    list->retiredfoot = NULL;
+    list->readers = NULL;
+    if (pthread_mutex_init(&list->mutex, NULL)) {
+        fprintf(stderr, "Out of memory\n");
+        return 1;
+    }
+    return 0;
+}
+
+int linkedlist_rcu_destroy(linkedlist_rcu_t *list) {
+    linkedlist_rcu_node_t *curr, *next;
+
+    /* Unlink every node at once and retire them. */
+    pthread_mutex_lock(&list->mutex);
+    curr = atomic_load_explicit(&list->head, memory_order_relaxed);
+    atomic_store_explicit(&list->head, NULL, memory_order_release);
+    list->foot = NULL;
+    atomic_store_explicit(&list->size, 0, memory_order_relaxed);
+    while (curr) {
+        next = atomic_load_explicit(&curr->next, memory_order_relaxed);
+        linkedlist_rcu_retire(list, curr);
+        curr = next;
+    }
+    pthread_mutex_unlock(&list->mutex);
+    linkedlist_rcu_synchronize(list);
+
+    /* Free the mutex once readers have finished. */
+    list->readers = NULL;
+    pthread_mutex_destroy(&list->mutex);
+    return 0;
+}
+
+int linkedlist_rcu_register(linkedlist_rcu_t *list,
+    linkedlist_rcu_reader_t *reader) {
+    atomic_init(&reader->epoch, 0);
+    reader->list = list;
+
+    pthread_mutex_lock(&list->mutex);
+    reader->next = list->readers;
+    list->readers = reader;
+    pthread_mutex_unlock(&list->mutex);
+    return 0;
+}
+
+int linkedlist_rcu_unregister(linkedlist_rcu_reader_t *reader) {
+    linkedlist_rcu_t *list = reader->list;
+    linkedlist_rcu_reader_t **curr;
+
+    pthread_mutex_lock(&list->mutex);
+    for (curr = &list->readers; *curr != reader; curr = &(*curr)->next) {
+        /* Cannot unregister reader from another list. */
+        if (!*curr) {
+            pthread_mutex_unlock(&list->mutex);
+            fprintf(stderr, "Reader is not registered\n");
+            return 1;
+        }
+    }
+    *curr = reader->next;
+    linkedlist_rcu_reclaim(list);
+    pthread_mutex_unlock(&list->mutex);
+    return 0;
+}
+
+int linkedlist_rcu_synchronize(linkedlist_rcu_t *list) {
+    int done;
+
+    /* Keep reclaiming until readers have moved on from every retired node. */
+    for (;;) {
+        pthread_mutex_lock(&list->mutex);
+        linkedlist_rcu_reclaim(list);
+        done = !list->retired;
+        pthread_mutex_unlock(&list->mutex);
+        if (done) {
+            return 0;
+        }
+        sched_yield();
+    }
+}
+
+
+size_t linkedlist_rcu_size(linkedlist_rcu_t *list) {
+    return atomic_load_explicit(&list->size, memory_order_relaxed);
+}
+
+int linkedlist_rcu_isempty(linkedlist_rcu_t *list) {
+    return atomic_load_explicit(&list->size, memory_order_relaxed) == 0;
+}
+
+
+int linkedlist_rcu_push(linkedlist_rcu_t *list, void *data) {
+    int ret;
+
+    pthread_mutex_lock(&list->mutex);
+    ret = linkedlist_rcu_insert(list, list->foot, data);
+    pthread_mutex_unlock(&list->mutex);
+    return ret;
+}
+
+void *linkedlist_rcu_pop(linkedlist_rcu_t *list) {
+    void *data;
+
+    pthread_mutex_lock(&list->mutex);
+
+    /* Cannot pop empty list. */
+    if (!list->foot) {
+        pthread_mutex_unlock(&list->mutex);
+        fprintf(stderr, "List is empty\n");
+        return NULL;
+    }
+
+    data = linkedlist_rcu_delete(list, list->foot);
+    pthread_mutex_unlock(&list->mutex);
+    return data;
+}
+
+int linkedlist_rcu_unshift(linkedlist_rcu_t *list, void *data) {
+    int ret;
+
+    pthread_mutex_lock(&list->mutex);
+    ret = linkedlist_rcu_insert(list, NULL, data);
+    pthread_mutex_unlock(&list->mutex);
+    return ret;
+}
+
+void *linkedlist_rcu_shift(linkedlist_rcu_t *list) {
+    linkedlist_rcu_node_t *head;
+    void *data;
+
+    pthread_mutex_lock(&list->mutex);
+
+    /* Cannot shift empty list. */
+    head = atomic_load_explicit(&list->head, memory_order_relaxed);
+    if (!head) {
+        pthread_mutex_unlock(&list->mutex);
+        fprintf(stderr, "List is empty\n");
+        return NULL;
+    }
+
+    data = linkedlist_rcu_delete(list, head);
+    pthread_mutex_unlock(&list->mutex);
+    return data;
+}
+
+int linkedlist_rcu_add(linkedlist_rcu_t *list, size_t index, void *data) {
+    int ret;
+
+    pthread_mutex_lock(&list->mutex);
+
+    /* Cannot add to index beyond list size. */
+    if (index > atomic_load_explicit(&list->size, memory_order_relaxed)) {
+        pthread_mutex_unlock(&list->mutex);
+        fprintf(stderr, "List out of range\n");
+        return 1;
+    }
+
+    ret = linkedlist_rcu_insert(list,
+        index ? linkedlist_rcu_node_at(list, index - 1) : NULL, data);
+    pthread_mutex_unlock(&list->mutex);
+    return ret;
+}
+
+void *linkedlist_rcu_remove(linkedlist_rcu_t *list, size_t index) {
+    size_t size;
+    void *data;
+
+    pthread_mutex_lock(&list->mutex);
+    size = atomic_load_explicit(&list->size, memory_order_relaxed);
+
+    /* Cannot remove from empty list. */
+    if (size == 0) {
+        pthread_mutex_unlock(&list->mutex);
+        fprintf(stderr, "List is empty\n");
+        return NULL;
+    }
+
+    /* Cannot remove from index beyond list size. */
+    if (index >= size) {
+        pthread_mutex_unlock(&list->mutex);
+        fprintf(stderr, "List out of range\n");
+        return NULL;
+    }
+
+    data = linkedlist_rcu_delete(list, linkedlist_rcu_node_at(list, index));
+    pthread_mutex_unlock(&list->mutex);
+    return data;
+}
+
+int linkedlist_rcu_set(linkedlist_rcu_t *list, size_t index, void *data) {
+    size_t size;
+
+    pthread_mutex_lock(&list->mutex);
+    size = atomic_load_explicit(&list->size, memory_order_relaxed);
+
+    /* Cannot set in empty list. */
+    if (size == 0) {
+        pthread_mutex_unlock(&list->mutex);
+        fprintf(stderr, "List is empty\n");
+        return 1;
+    }
+
+    /* Cannot set from index beyond list size. */
+    if (index >= size) {
+        pthread_mutex_unlock(&list->mutex);
+        fprintf(stderr, "List out of range\n");
+        return 1;
+    }
+
+    atomic_store_explicit(&linkedlist_rcu_node_at(list, index)->data, data,
+        memory_order_release);
+    pthread_mutex_unlock(&list->mutex);
+    return 0;
+}
+
+
+void *linkedlist_rcu_get(linkedlist_rcu_reader_t *reader, size_t index) {
+    linkedlist_rcu_node_t *curr;
+    void *data = NULL;
+    size_t i = 0;
+
+    linkedlist_rcu_enter(reader);
+    curr = atomic_load_explicit(&reader->list->head, memory_order_acquire);
+
+    /* Cannot get from empty list. */
+    if (!curr) {
+        linkedlist_rcu_leave(reader);
+        fprintf(stderr, "List is empty\n");
+        return NULL;
+    }
+
+    /* Walk to node, unless the list is shorter than index. */
+    while (curr && i < index) {
+        curr = atomic_load_explicit(&curr->next, memory_order_acquire);
+        i++;
+    }
+    if (curr) {
+        data = atomic_load_explicit(&curr->data, memory_order_acquire);
+    }
+    linkedlist_rcu_leave(reader);
+
+    /* Cannot get from index beyond list size. */
+    if (!curr) {
+        fprintf(stderr, "List out of range\n");
+    }
+    return data;
+}
+
+size_t linkedlist_rcu_indexof(linkedlist_rcu_reader_t *reader, void *data) {
+    linkedlist_rcu_node_t *curr;
+    size_t i = 0;
+
+    /* Search list until item is found. */
+    linkedlist_rcu_enter(reader);
+    curr = atomic_load_explicit(&reader->list->head, memory_order_acquire);
+    while (curr && atomic_load_explicit(&curr->data, memory_order_relaxed)
+        != data) {
+        curr = atomic_load_explicit(&curr->next, memory_order_acquire);
+        i++;
+    }
+    linkedlist_rcu_leave(reader);
+    return i;
+}
+
+void *linkedlist_rcu_find(linkedlist_rcu_reader_t *reader, int (*f)(void *)) {
+    linkedlist_rcu_node_t *curr;
+    void *data = NULL;
+
+    /* Search list until item that pass the test is found. */
+    linkedlist_rcu_enter(reader);
+    curr = atomic_load_explicit(&reader->list->head, memory_order_acquire);
+    while (curr) {
+        data = atomic_load_explicit(&curr->data, memory_order_acquire);
+        if (f(data) == 1) {
+            break;
+        }
+        data = NULL;
+        curr = atomic_load_explicit(&curr->next, memory_order_acquire);
+    }
+    linkedlist_rcu_leave(reader);
+    return data;
+}
+
+size_t linkedlist_rcu_findindex(linkedlist_rcu_reader_t *reader,
+    int (*f)(void *)) {
+    linkedlist_rcu_node_t *curr;
+    size_t i = 0;
+
+    /* Search list until item that pass the test is found. */
+    linkedlist_rcu_enter(reader);
+    curr = atomic_load_explicit(&reader->list->head, memory_order_acquire);
+    while (curr && f(atomic_load_explicit(&curr->data,
+        memory_order_acquire)) != 1) {
+        curr = atomic_load_explicit(&curr->next, memory_order_acquire);
+        i++;
+    }
+    linkedlist_rcu_leave(reader);
+    return i;
+}
+
+int linkedlist_rcu_foreach(linkedlist_rcu_reader_t *reader,
+    void (*f)(void *)) {
+    linkedlist_rcu_node_t *curr;
+
+    /* Iterate over list and execute function on each item. */
+    linkedlist_rcu_enter(reader);
+    curr = atomic_load_explicit(&reader->list->head, memory_order_acquire);
+    while (curr) {
+        f(atomic_load_explicit(&curr->data, memory_order_acquire));
+        curr = atomic_load_explicit(&curr->next, memory_order_acquire);
+    }
+    linkedlist_rcu_leave(reader);
+    return 0;
+}
@@ -0,0 +1,102 @@
+/*
+ * linkedlist_rcu.h
+ * Version 20261018
+ * Written by Harry Wong (RedAndBlueEraser)
+ */
+
+#ifndef LINKEDLIST_RCU_H
+#define LINKEDLIST_RCU_H
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stddef.h>
+
+typedef struct linkedlist_rcu_node_t {
+    _Atomic(struct linkedlist_rcu_node_t *) next;
+    _Atomic(void *) data;
+    struct linkedlist_rcu_node_t *prev;
+    struct linkedlist_rcu_node_t *retired;
+    size_t epoch;
+} linkedlist_rcu_node_t;
+
+typedef struct linkedlist_rcu_reader_t {
+    _Alignas(64) atomic_size_t epoch;
+    struct linkedlist_rcu_t *list;
+    struct linkedlist_rcu_reader_t *next;
+} linkedlist_rcu_reader_t;
+
+typedef struct linkedlist_rcu_t {
+    _Atomic(linkedlist_rcu_node_t *) head;
+    linkedlist_rcu_node_t *foot;
+    atomic_size_t size;
+    atomic_size_t epoch;
+    linkedlist_rcu_node_t *retired;
+    linkedlist_rcu_node_t *retiredfoot;
+    linkedlist_rcu_reader_t *readers;
+    pthread_mutex_t mutex;
+} linkedlist_rcu_t;
+
+/* Create a new empty list. Returns 0 on success. */
+int linkedlist_rcu_create(linkedlist_rcu_t *list);
+/* Empty the list, waiting for readers to finish with its nodes, and free its
+ * memory, leaving it unusable until it is created again. Must be called once
+ * no other thread uses the list and every reader is unregistered. Returns 0
+ * on success.
+ */
+int linkedlist_rcu_destroy(linkedlist_rcu_t *list);
+/* Register a reader with the list, for a thread to read the list with. Returns
+ * 0 on success.
+ */
+int linkedlist_rcu_register(linkedlist_rcu_t *list,
+    linkedlist_rcu_reader_t *reader);
+/* Unregister a reader from its list. Returns 0 on success. */
+int linkedlist_rcu_unregister(linkedlist_rcu_reader_t *reader);
+/* Wait until readers have finished with every removed node and free them.
+ * Returns 0 on success.
+ */
+int linkedlist_rcu_synchronize(linkedlist_rcu_t *list);
+
+/* Get and return the number of items in the list. */
+size_t linkedlist_rcu_size(linkedlist_rcu_t *list);
+/* Check if list contains no items. */
+int linkedlist_rcu_isempty(linkedlist_rcu_t *list);
+
+/* Add an item to the end of the list. Returns 0 on success. */
+int linkedlist_rcu_push(linkedlist_rcu_t *list, void *data);
+/* Remove and return the item on the end of the list. */
+void *linkedlist_rcu_pop(linkedlist_rcu_t *list);
+/* Add an item to the start of the list. Returns 0 on success. */
+int linkedlist_rcu_unshift(linkedlist_rcu_t *list, void *data);
+/* Remove and return the item on the start of the list. */
+void *linkedlist_rcu_shift(linkedlist_rcu_t *list);
+/* Add an item to the specified position in the list. Returns 0 on success. */
+int linkedlist_rcu_add(linkedlist_rcu_t *list, size_t index, void *data);
+/* Remove and return the item in the specified position of the list. */
+void *linkedlist_rcu_remove(linkedlist_rcu_t *list, size_t index);
+/* Replace an item in the specified position of the list. Returns 0 on success.
+ */
+int linkedlist_rcu_set(linkedlist_rcu_t *list, size_t index, void *data);
+
+/* Get and return the item in the specified position in the reader's list. */
+void *linkedlist_rcu_get(linkedlist_rcu_reader_t *reader, size_t index);
+/* Find and return the index of the specified item in the reader's list.
+ * Returns the number of items passed if the item is not found.
+ */
+size_t linkedlist_rcu_indexof(linkedlist_rcu_reader_t *reader, void *data);
+/* Find and return the first item in the reader's list that pass the test
+ * (provided as a function where a pass is 1). Returns null if no items pass the
+ * test.
+ */
+void *linkedlist_rcu_find(linkedlist_rcu_reader_t *reader, int (*f)(void *));
+/* Find and return the index of the first item in the reader's list that pass
+ * the test (provided as a function where a pass is 1). Returns the number of
+ * items passed if no items pass the test.
+ */
+size_t linkedlist_rcu_findindex(linkedlist_rcu_reader_t *reader,
+    int (*f)(void *));
+/* Iterate over the reader's list and execute a function on each item. Returns
+ * 0 on success.
+ */
+int linkedlist_rcu_foreach(linkedlist_rcu_reader_t *reader, void (*f)(void *));
+
+#endif
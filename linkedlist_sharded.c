@@ -0,0 +1,140 @@
+/*
+ * linkedlist_sharded.c
+ * Version 20261018
+ * Written by Harry Wong (RedAndBlueEraser)
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "linkedlist_sharded.h"
+
+/*
+ * Each shard is a list only its own thread pushes to. Full batches of its
+ * nodes are moved to a batch list and pushed onto the shard's mailbox, a
+ * stack which the flushing thread empties at once. Nodes are allocated with
+ * malloc, so that batches move between lists without copying.
+ */
+
+static void linkedlist_sharded_free(linkedlist_batch_t *batch) {
+    linkedlist_batch_t *next;
+
+    /* Free a stack of batches and their nodes. */
+    while (batch) {
+        next = batch->next;
+        linkedlist_destroy(&batch->list);
+        free(batch);
+        batch = next;
+    }
+}
+
+
+int linkedlist_sharded_create(linkedlist_sharded_t *sharded, size_t count) {
+    size_t i;
+
+    /* Allocate shards on separate cache lines. */
+    sharded->shards = count > 0 ? (linkedlist_shard_t*)aligned_alloc(
+        _Alignof(linkedlist_shard_t), count * sizeof *sharded->shards) : NULL;
+    if (count > 0 && !sharded->shards) {
+        fprintf(stderr, "Out of memory\n");
+        return 1;
+    }
+    sharded->count = count;
+
+    /* Initialise shard attributes. */
+    for (i = 0; i < count; i++) {
+        linkedlist_create(&sharded->shards[i].list);
+        atomic_init(&sharded->shards[i].mailbox, NULL);
+    }
+    return 0;
+}
+
+int linkedlist_sharded_destroy(linkedlist_sharded_t *sharded) {
+    size_t i;
+
+    /* Free the items of every shard, handed over or not. */
+    for (i = 0; i < sharded->count; i++) {
+        linkedlist_destroy(&sharded->shards[i].list);
+        linkedlist_sharded_free(atomic_exchange(&sharded->shards[i].mailbox,
+            NULL));
+    }
+    free(sharded->shards);
+    sharded->shards = NULL;
+    sharded->count = 0;
+    return 0;
+}
+
+
+int linkedlist_sharded_push(linkedlist_sharded_t *sharded, size_t shard,
+    void *data) {
+    linkedlist_t *list = &sharded->shards[shard].list;
+
+    if (linkedlist_push(list, data)) {
+        return 1;
+    }
+
+    /* Hand over a full batch, or try again on the next push if that fails. */
+    if (linkedlist_size(list) >= LINKEDLIST_SHARDED_BATCH) {
+        linkedlist_sharded_publish(sharded, shard);
+    }
+    return 0;
+}
+
+int linkedlist_sharded_publish(linkedlist_sharded_t *sharded, size_t shard) {
+    linkedlist_shard_t *s = &sharded->shards[shard];
+    linkedlist_batch_t *batch;
+
+    if (linkedlist_isempty(&s->list)) {
+        return 0;
+    }
+    batch = (linkedlist_batch_t*)malloc(sizeof *batch);
+    if (!batch) {
+        fprintf(stderr, "Out of memory\n");
+        return 1;
+    }
+
+    /* Move every node of the shard to the batch, then push the batch onto the
+     * mailbox.
+     */
+    linkedlist_split(&s->list, 0, &batch->list);
+    batch->next = atomic_load_explicit(&s->mailbox, memory_order_relaxed);
+    while (!atomic_compare_exchange_weak_explicit(&s->mailbox, &batch->next,
+        batch, memory_order_release, memory_order_relaxed)) {
+        /* batch->next now holds the top of the mailbox again. */
+    }
+    return 0;
+}
+
+int linkedlist_sharded_flush(linkedlist_sharded_t *sharded, linkedlist_t *dest,
+    int ordered) {
+    linkedlist_batch_t *batch, *next, *prev;
+    size_t i;
+
+    linkedlist_create(dest);
+    for (i = 0; i < sharded->count; i++) {
+        /* Take every batch in the mailbox at once, newest first. */
+        batch = atomic_exchange_explicit(&sharded->shards[i].mailbox, NULL,
+            memory_order_acquire);
+
+        /* Reverse the batches to put them in the order they were pushed. */
+        if (ordered) {
+            prev = NULL;
+            while (batch) {
+                next = batch->next;
+                batch->next = prev;
+                prev = batch;
+                batch = next;
+            }
+            batch = prev;
+        }
+
+        /* Move each batch's nodes onto the end of dest. */
+        while (batch) {
+            next = batch->next;
+            linkedlist_concat(dest, &batch->list);
+            linkedlist_destroy(&batch->list);
+            free(batch);
+            batch = next;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,59 @@
+/*
+ * linkedlist_sharded.h
+ * Version 20261018
+ * Written by Harry Wong (RedAndBlueEraser)
+ */
+
+#ifndef LINKEDLIST_SHARDED_H
+#define LINKEDLIST_SHARDED_H
+
+#include <stdatomic.h>
+#include <stddef.h>
+#include "linkedlist.h"
+
+/* Number of items a shard collects before handing them over to be flushed. */
+#ifndef LINKEDLIST_SHARDED_BATCH
+#define LINKEDLIST_SHARDED_BATCH 256
+#endif
+
+typedef struct linkedlist_batch_t {
+    struct linkedlist_batch_t *next;
+    linkedlist_t list;
+} linkedlist_batch_t;
+
+typedef struct linkedlist_shard_t {
+    _Alignas(64) linkedlist_t list;
+    _Alignas(64) _Atomic(linkedlist_batch_t *) mailbox;
+} linkedlist_shard_t;
+
+typedef struct linkedlist_sharded_t {
+    linkedlist_shard_t *shards;
+    size_t count;
+} linkedlist_sharded_t;
+
+/* Create a new empty sharded list with count shards, one for each thread which
+ * pushes to it. Returns 0 on success.
+ */
+int linkedlist_sharded_create(linkedlist_sharded_t *sharded, size_t count);
+/* Empty the sharded list, including items not yet flushed. Must not be called
+ * while other threads use the list. Returns 0 on success.
+ */
+int linkedlist_sharded_destroy(linkedlist_sharded_t *sharded);
+
+/* Add an item to the end of the specified shard, which only one thread may
+ * push to at a time. Returns 0 on success.
+ */
+int linkedlist_sharded_push(linkedlist_sharded_t *sharded, size_t shard,
+    void *data);
+/* Hand over the items pushed to the specified shard so that the next flush
+ * takes them, from the thread which pushes to it. Returns 0 on success.
+ */
+int linkedlist_sharded_publish(linkedlist_sharded_t *sharded, size_t shard);
+/* Move the items handed over by every shard to a new dest list, keeping the
+ * order each shard's items were pushed in if ordered is 1. Returns 0 on
+ * success.
+ */
+int linkedlist_sharded_flush(linkedlist_sharded_t *sharded, linkedlist_t *dest,
+    int ordered);
+
+#endif
@@ -0,0 +1,487 @@
+/*
+ * linkedlist_skip.c
+ * Version 20261018
+ * Written by Harry Wong (RedAndBlueEraser)
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "linkedlist_skip.h"
+
+#define MAXLEVEL LINKEDLIST_SKIP_MAXLEVEL
+
+/*
+ * Items are numbered by position from 1, with the head at position 0. Each
+ * link spans the number of positions to the node it points to. Links from the
+ * head, and the positions of the last node of each level, are kept as tickets
+ * (position plus offset) instead, so that shifting the list only needs to
+ * increment the offset rather than update every level.
+ */
+
+static linkedlist_skip_node_t *linkedlist_skip_nodeof(
+    linkedlist_skip_link_t *links) {
+    return (linkedlist_skip_node_t*)((char*)links
+        - offsetof(linkedlist_skip_node_t, links));
+}
+
+static size_t linkedlist_skip_span(linkedlist_skip_t *list,
+    linkedlist_skip_link_t *links, size_t level) {
+    return links == list->head
+        ? links[level].span - list->offset : links[level].span;
+}
+
+static void linkedlist_skip_setspan(linkedlist_skip_t *list,
+    linkedlist_skip_link_t *links, size_t level, size_t span) {
+    links[level].span = links == list->head ? span + list->offset : span;
+}
+
+static size_t linkedlist_skip_tailpos(linkedlist_skip_t *list, size_t level) {
+    return list->tails[level] == list->head
+        ? 0 : list->tailtickets[level] - list->offset;
+}
+
+static size_t linkedlist_skip_randomlevel(linkedlist_skip_t *list) {
+    uint64_t x = list->seed;
+    size_t level = 1;
+
+    /* Step a xorshift generator and raise the level with probability 1/4. */
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    list->seed = x;
+    while ((x & 3) == 0 && level < MAXLEVEL) {
+        level++;
+        x >>= 2;
+    }
+    return level;
+}
+
+static void linkedlist_skip_search(linkedlist_skip_t *list, size_t pos,
+    linkedlist_skip_link_t **update, size_t *updatepos) {
+    linkedlist_skip_link_t *curr = list->head;
+    size_t currpos = 0, span, level = list->level;
+
+    /* Find the last node before pos on every level. */
+    while (level-- > 0) {
+        while (curr[level].next
+            && currpos + (span = linkedlist_skip_span(list, curr, level))
+                < pos) {
+            currpos += span;
+            curr = curr[level].next->links;
+        }
+        update[level] = curr;
+        updatepos[level] = currpos;
+    }
+}
+
+static linkedlist_skip_node_t *linkedlist_skip_locate(linkedlist_skip_t *list,
+    size_t pos) {
+    linkedlist_skip_link_t *curr = list->head;
+    size_t currpos = 0, span, level = list->level;
+
+    /* The last node is always at hand. */
+    if (pos == list->size) {
+        return linkedlist_skip_nodeof(list->tails[0]);
+    }
+
+    /* Take the highest lane that does not overshoot pos. */
+    while (level-- > 0 && currpos < pos) {
+        while (curr[level].next
+            && currpos + (span = linkedlist_skip_span(list, curr, level))
+                <= pos) {
+            currpos += span;
+            curr = curr[level].next->links;
+        }
+    }
+    return linkedlist_skip_nodeof(curr);
+}
+
+static void linkedlist_skip_raise(linkedlist_skip_t *list, size_t level) {
+    /* Add empty levels to the list. */
+    while (list->level < level) {
+        list->head[list->level].next = NULL;
+        list->tails[list->level] = list->head;
+        list->level++;
+    }
+}
+
+static void linkedlist_skip_lower(linkedlist_skip_t *list) {
+    /* Drop empty levels from the list. */
+    while (list->level > 0 && !list->head[list->level - 1].next) {
+        list->level--;
+    }
+}
+
+static int linkedlist_skip_insert(linkedlist_skip_t *list, size_t pos,
+    void *data) {
+    linkedlist_skip_link_t *update[MAXLEVEL];
+    linkedlist_skip_node_t *node, *next;
+    size_t level = linkedlist_skip_randomlevel(list), updatepos[MAXLEVEL], i;
+
+    /* Create new node. */
+    node = (linkedlist_skip_node_t*)malloc(sizeof *node
+        + sizeof node->links[0] * level);
+    if (!node) {
+        fprintf(stderr, "Out of memory\n");
+        return 1;
+    }
+    node->data = data;
+    node->level = level;
+    linkedlist_skip_raise(list, level);
+
+    /* Add node after the last node of its levels at the end of the list. */
+    if (pos == list->size + 1) {
+        for (i = 0; i < level; i++) {
+            node->links[i].next = NULL;
+            list->tails[i][i].next = node;
+            linkedlist_skip_setspan(list, list->tails[i], i,
+                pos - linkedlist_skip_tailpos(list, i));
+            list->tails[i] = node->links;
+            list->tailtickets[i] = pos + list->offset;
+        }
+        list->size++;
+        return 0;
+    }
+
+    /* Add node after the last node before pos on its levels, and lengthen the
+     * links passing over it on the levels above.
+     */
+    linkedlist_skip_search(list, pos, update, updatepos);
+    for (i = 0; i < list->level; i++) {
+        next = update[i][i].next;
+        if (i < level) {
+            node->links[i].next = next;
+            if (next) {
+                node->links[i].span = updatepos[i]
+                    + linkedlist_skip_span(list, update[i], i) + 1 - pos;
+                list->tailtickets[i]++;
+            } else {
+                list->tails[i] = node->links;
+                list->tailtickets[i] = pos + list->offset;
+            }
+            update[i][i].next = node;
+            linkedlist_skip_setspan(list, update[i], i, pos - updatepos[i]);
+        } else if (next) {
+            linkedlist_skip_setspan(list, update[i], i,
+                linkedlist_skip_span(list, update[i], i) + 1);
+            list->tailtickets[i]++;
+        }
+    }
+    list->size++;
+    return 0;
+}
+
+static void *linkedlist_skip_delete(linkedlist_skip_t *list, size_t pos) {
+    linkedlist_skip_link_t *update[MAXLEVEL];
+    linkedlist_skip_node_t *node, *next;
+    size_t updatepos[MAXLEVEL], i;
+    void *data;
+
+    if (pos == 1) {
+        /* Unlink the first node from the head on its levels only. The tickets
+         * of every other link stay the same.
+         */
+        node = list->head[0].next;
+        for (i = 0; i < node->level; i++) {
+            next = node->links[i].next;
+            list->head[i].next = next;
+            if (next) {
+                list->head[i].span = node->links[i].span + list->offset + 1;
+            } else {
+                list->tails[i] = list->head;
+            }
+        }
+        list->offset++;
+    } else {
+        /* Unlink node from the last node before pos on its levels, and
+         * shorten the links passing over it on the levels above.
+         */
+        linkedlist_skip_search(list, pos, update, updatepos);
+        node = update[0][0].next;
+        for (i = 0; i < list->level; i++) {
+            next = update[i][i].next;
+            if (next == node) {
+                update[i][i].next = node->links[i].next;
+                if (node->links[i].next) {
+                    linkedlist_skip_setspan(list, update[i], i,
+                        linkedlist_skip_span(list, update[i], i)
+                            + node->links[i].span - 1);
+                    list->tailtickets[i]--;
+                } else {
+                    list->tails[i] = update[i];
+                    list->tailtickets[i] = updatepos[i] + list->offset;
+                }
+            } else if (next) {
+                linkedlist_skip_setspan(list, update[i], i,
+                    linkedlist_skip_span(list, update[i], i) - 1);
+                list->tailtickets[i]--;
+            }
+        }
+    }
+
+    linkedlist_skip_lower(list);
+    list->size--;
+    data = node->data;
+    free(node);
+    return data;
+}
+
+int linkedlist_skip_create(linkedlist_skip_t *list) {
+    /* Initialise list attributes. */
+    list->size = 0;
+    list->level = 0;
+    list->offset = 0;
+    list->seed = 0x2545F4914F6CDD1DULL;
+    return 0;
+}
+
+int linkedlist_skip_destroy(linkedlist_skip_t *list) {
+    /* Free memory allocated for nodes in the list. */
+    linkedlist_skip_node_t *curr = list->level > 0 ? list->head[0].next : NULL,
+        *next;
+    while (curr) {
+        next = curr->links[0].next;
+        free(curr);
+        curr = next;
+    }
+
+    /* Create a new empty list. */
+    return linkedlist_skip_create(list);
+}
+
+int linkedlist_skip_clone(linkedlist_skip_t *src, linkedlist_skip_t *dest) {
+    linkedlist_skip_node_t *curr = src->level > 0 ? src->head[0].next : NULL;
+
+    /* Create a new empty list for dest. */
+    linkedlist_skip_create(dest);
+
+    /* Copy items from src to dest. */
+    while (curr) {
+        if (linkedlist_skip_push(dest, curr->data) != 0) {
+            linkedlist_skip_destroy(dest);
+            return 1;
+        }
+        curr = curr->links[0].next;
+    }
+    return 0;
+}
+
+
+size_t linkedlist_skip_size(linkedlist_skip_t *list) {
+    return list->size;
+}
+
+int linkedlist_skip_isempty(linkedlist_skip_t *list) {
+    return list->size == 0;
+}
+
+
+int linkedlist_skip_push(linkedlist_skip_t *list, void *data) {
+    return linkedlist_skip_insert(list, list->size + 1, data);
+}
+
+void *linkedlist_skip_pop(linkedlist_skip_t *list) {
+    /* Cannot pop empty list. */
+    if (list->size == 0) {
+        fprintf(stderr, "List is empty\n");
+        return NULL;
+    }
+
+    return linkedlist_skip_delete(list, list->size);
+}
+
+int linkedlist_skip_unshift(linkedlist_skip_t *list, void *data) {
+    return linkedlist_skip_insert(list, 1, data);
+}
+
+void *linkedlist_skip_shift(linkedlist_skip_t *list) {
+    /* Cannot shift empty list. */
+    if (list->size == 0) {
+        fprintf(stderr, "List is empty\n");
+        return NULL;
+    }
+
+    return linkedlist_skip_delete(list, 1);
+}
+
+int linkedlist_skip_add(linkedlist_skip_t *list, size_t index, void *data) {
+    /* Cannot add to index beyond list size. */
+    if (index > list->size) {
+        fprintf(stderr, "List out of range\n");
+        return 1;
+    }
+
+    return linkedlist_skip_insert(list, index + 1, data);
+}
+
+void *linkedlist_skip_remove(linkedlist_skip_t *list, size_t index) {
+    /* Cannot remove from empty list. */
+    if (list->size == 0) {
+        fprintf(stderr, "List is empty\n");
+        return NULL;
+    }
+
+    /* Cannot remove from index beyond list size. */
+    if (index >= list->size) {
+        fprintf(stderr, "List out of range\n");
+        return NULL;
+    }
+
+    return linkedlist_skip_delete(list, index + 1);
+}
+
+int linkedlist_skip_set(linkedlist_skip_t *list, size_t index, void *data) {
+    /* Cannot set in empty list. */
+    if (list->size == 0) {
+        fprintf(stderr, "List is empty\n");
+        return 1;
+    }
+
+    /* Cannot set from index beyond list size. */
+    if (index >= list->size) {
+        fprintf(stderr, "List out of range\n");
+        return 1;
+    }
+
+    linkedlist_skip_locate(list, index + 1)->data = data;
+    return 0;
+}
+
+int linkedlist_skip_addarray(linkedlist_skip_t *dest, void *src[]) {
+    void *data;
+    size_t i = 0;
+
+    /* Add items from src to dest. */
+    while ((data = src[i++])) {
+        if (linkedlist_skip_push(dest, data) != 0) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+
+void *linkedlist_skip_get(linkedlist_skip_t *list, size_t index) {
+    /* Cannot get from empty list. */
+    if (list->size == 0) {
+        fprintf(stderr, "List is empty\n");
+        return NULL;
+    }
+
+    /* Cannot get from index beyond list size. */
+    if (index >= list->size) {
+        fprintf(stderr, "List out of range\n");
+        return NULL;
+    }
+
+    return linkedlist_skip_locate(list, index + 1)->data;
+}
+
+void *linkedlist_skip_first(linkedlist_skip_t *list) {
+    /* Cannot get from empty list. */
+    if (list->size == 0) {
+        fprintf(stderr, "List is empty\n");
+        return NULL;
+    }
+
+    return list->head[0].next->data;
+}
+
+void *linkedlist_skip_last(linkedlist_skip_t *list) {
+    /* Cannot get from empty list. */
+    if (list->size == 0) {
+        fprintf(stderr, "List is empty\n");
+        return NULL;
+    }
+
+    return linkedlist_skip_nodeof(list->tails[0])->data;
+}
+
+size_t linkedlist_skip_indexof(linkedlist_skip_t *list, void *data) {
+    linkedlist_skip_node_t *curr = list->level > 0 ? list->head[0].next : NULL;
+    size_t index = 0;
+
+    /* Test each item until an item passes the test. */
+    while (curr) {
+        if (curr->data == data) {
+            break;
+        }
+        curr = curr->links[0].next;
+        index++;
+    }
+    return index;
+}
+
+void *linkedlist_skip_find(linkedlist_skip_t *list, int (*f)(void *)) {
+    linkedlist_skip_node_t *curr = list->level > 0 ? list->head[0].next : NULL;
+
+    /* Test each item until an item passes the test. */
+    while (curr) {
+        if (f(curr->data) == 1) {
+            return curr->data;
+        }
+        curr = curr->links[0].next;
+    }
+    return NULL;
+}
+
+size_t linkedlist_skip_findindex(linkedlist_skip_t *list, int (*f)(void *)) {
+    linkedlist_skip_node_t *curr = list->level > 0 ? list->head[0].next : NULL;
+    size_t index = 0;
+
+    /* Test each item until an item passes the test. */
+    while (curr) {
+        if (f(curr->data) == 1) {
+            break;
+        }
+        curr = curr->links[0].next;
+        index++;
+    }
+    return index;
+}
+
+int linkedlist_skip_foreach(linkedlist_skip_t *list, void (*f)(void *)) {
+    linkedlist_skip_node_t *curr = list->level > 0 ? list->head[0].next : NULL;
+
+    /* Execute function on every item. */
+    while (curr) {
+        f(curr->data);
+        curr = curr->links[0].next;
+    }
+    return 0;
+}
+
+
+int linkedlist_skip_slice(linkedlist_skip_t *list, size_t start, size_t end) {
+    /* Slice to empty list. */
+    if (start >= end || start >= list->size) {
+        return linkedlist_skip_destroy(list);
+    }
+    /* Slice to end of list. */
+    if (end > list->size) {
+        end = list->size;
+    }
+
+    /* Remove items from end onwards, then items before start. */
+    while (list->size > end) {
+        linkedlist_skip_delete(list, list->size);
+    }
+    while (start-- > 0) {
+        linkedlist_skip_delete(list, 1);
+    }
+    return 0;
+}
+
+int linkedlist_skip_toarray(linkedlist_skip_t *src, void *dest[]) {
+    linkedlist_skip_node_t *curr = src->level > 0 ? src->head[0].next : NULL;
+    size_t index = 0;
+
+    /* Copies each item from the list to the array. */
+    while (curr) {
+        dest[index] = curr->data;
+        curr = curr->links[0].next;
+        index++;
+    }
+    dest[index] = NULL;
+    return 0;
+}
@@ -0,0 +1,104 @@
+/*
+ * linkedlist_skip.h
+ * Version 20261018
+ * Written by Harry Wong (RedAndBlueEraser)
+ */
+
+#ifndef LINKEDLIST_SKIP_H
+#define LINKEDLIST_SKIP_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* Maximum number of levels of express lanes. Each level holds about a quarter
+ * of the nodes of the level below it.
+ */
+#ifndef LINKEDLIST_SKIP_MAXLEVEL
+#define LINKEDLIST_SKIP_MAXLEVEL 24
+#endif
+
+typedef struct linkedlist_skip_link_t {
+    struct linkedlist_skip_node_t *next;
+    size_t span;
+} linkedlist_skip_link_t;
+
+typedef struct linkedlist_skip_node_t {
+    void *data;
+    size_t level;
+    linkedlist_skip_link_t links[];
+} linkedlist_skip_node_t;
+
+typedef struct linkedlist_skip_t {
+    linkedlist_skip_link_t head[LINKEDLIST_SKIP_MAXLEVEL];
+    linkedlist_skip_link_t *tails[LINKEDLIST_SKIP_MAXLEVEL];
+    size_t tailtickets[LINKEDLIST_SKIP_MAXLEVEL];
+    size_t size;
+    size_t level;
+    size_t offset;
+    uint64_t seed;
+} linkedlist_skip_t;
+
+/* Create a new empty list. Returns 0 on success. */
+int linkedlist_skip_create(linkedlist_skip_t *list);
+/* Empty the list. Returns 0 on success. */
+int linkedlist_skip_destroy(linkedlist_skip_t *list);
+/* Copies a list. */
+int linkedlist_skip_clone(linkedlist_skip_t *src, linkedlist_skip_t *dest);
+
+/* Get and return the number of items in the list. */
+size_t linkedlist_skip_size(linkedlist_skip_t *list);
+/* Check if list contains no items. */
+int linkedlist_skip_isempty(linkedlist_skip_t *list);
+
+/* Add an item to the end of the list. Returns 0 on success. */
+int linkedlist_skip_push(linkedlist_skip_t *list, void *data);
+/* Remove and return the item on the end of the list. */
+void *linkedlist_skip_pop(linkedlist_skip_t *list);
+/* Add an item to the start of the list. Returns 0 on success. */
+int linkedlist_skip_unshift(linkedlist_skip_t *list, void *data);
+/* Remove and return the item on the start of the list. */
+void *linkedlist_skip_shift(linkedlist_skip_t *list);
+/* Add an item to the specified position in the list. Returns 0 on success. */
+int linkedlist_skip_add(linkedlist_skip_t *list, size_t index, void *data);
+/* Remove and return the item in the specified position of the list. */
+void *linkedlist_skip_remove(linkedlist_skip_t *list, size_t index);
+/* Replace an item in the specified position of the list. Returns 0 on success.
+ */
+int linkedlist_skip_set(linkedlist_skip_t *list, size_t index, void *data);
+/* Add the items from the null-terminated array to the end of the list. Returns
+ * 0 on success.
+ */
+int linkedlist_skip_addarray(linkedlist_skip_t *dest, void *src[]);
+
+/* Get and return the item in the specified position in the list. */
+void *linkedlist_skip_get(linkedlist_skip_t *list, size_t index);
+/* Get and return the first item in the list. */
+void *linkedlist_skip_first(linkedlist_skip_t *list);
+/* Get and return the last item in the list. */
+void *linkedlist_skip_last(linkedlist_skip_t *list);
+/* Find and return the index of the specified item in the list. Returns the
+ * number of items in the list if the item is not found.
+ */
+size_t linkedlist_skip_indexof(linkedlist_skip_t *list, void *data);
+/* Find and return the first item in the list that pass the test (provided as a
+ * function where a pass is 1). Returns null if no items pass the test.
+ */
+void *linkedlist_skip_find(linkedlist_skip_t *list, int (*f)(void *));
+/* Find and return the index of the first item in the list that pass the test
+ * (provided as a function where a pass is 1). Returns the number of items in
+ * the list if no items pass the test.
+ */
+size_t linkedlist_skip_findindex(linkedlist_skip_t *list, int (*f)(void *));
+/* Iterate over the list and execute a function on each item. Returns 0 on
+ * success.
+ */
+int linkedlist_skip_foreach(linkedlist_skip_t *list, void (*f)(void *));
+
+/* Slice the list from including start to excluding end. Returns 0 on
+ * success.
+ */
+int linkedlist_skip_slice(linkedlist_skip_t *list, size_t start, size_t end);
+/* Represents the list as a null-terminated array. Returns 0 on success. */
+int linkedlist_skip_toarray(linkedlist_skip_t *src, void *dest[]);
+
+#endif
@@ -0,0 +1,447 @@
+/*
+ * linkedlist_typed.h
+ * Version 20261018
+ * Written by Harry Wong (RedAndBlueEraser)
+ */
+
+#ifndef LINKEDLIST_TYPED_H
+#define LINKEDLIST_TYPED_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stddef.h>
+
+/* Declare a list type name##_t which stores items of type T inside its nodes,
+ * and its functions name##_create() and so on. The functions called for every
+ * item (size, isempty, first, last, push, pop, unshift and shift) are defined
+ * here as static inline functions, and the rest must be defined once with
+ * LINKEDLIST_DEFINE(name, T).
+ */
+#define LINKEDLIST_DECLARE(name, T)                                           \
+typedef struct name##_node_t {                                                \
+    struct name##_node_t *next;                                               \
+    struct name##_node_t *prev;                                               \
+    T data;                                                                   \
+} name##_node_t;                                                              \
+                                                                              \
+typedef struct name##_t {                                                     \
+    name##_node_t *head;                                                      \
+    name##_node_t *foot;                                                      \
+    size_t size;                                                              \
+} name##_t;                                                                   \
+                                                                              \
+/* Create a new empty list. Returns 0 on success. */                          \
+int name##_create(name##_t *list);                                            \
+/* Empty the list. Returns 0 on success. */                                   \
+int name##_destroy(name##_t *list);                                           \
+/* Copies a list. Returns 0 on success. */                                    \
+int name##_clone(name##_t *src, name##_t *dest);                              \
+/* Add an item to the specified position in the list. Returns 0 on success.   \
+ */                                                                           \
+int name##_add(name##_t *list, size_t index, T data);                         \
+/* Remove the item in the specified position of the list, copying it to data  \
+ * unless data is null. Returns 0 on success.                                 \
+ */                                                                           \
+int name##_remove(name##_t *list, size_t index, T *data);                     \
+/* Replace an item in the specified position of the list. Returns 0 on        \
+ * success.                                                                   \
+ */                                                                           \
+int name##_set(name##_t *list, size_t index, T data);                         \
+/* Get and return a pointer to the item in the specified position in the      \
+ * list.                                                                      \
+ */                                                                           \
+T *name##_get(name##_t *list, size_t index);                                  \
+/* Find and return a pointer to the first item in the list that pass the test \
+ * (provided as a function where a pass is 1). Returns null if no items pass  \
+ * the test.                                                                  \
+ */                                                                           \
+T *name##_find(name##_t *list, int (*f)(const T *));                          \
+/* Find and return the index of the first item in the list that pass the test \
+ * (provided as a function where a pass is 1). Returns the number of items in \
+ * the list if no items pass the test.                                        \
+ */                                                                           \
+size_t name##_findindex(name##_t *list, int (*f)(const T *));                 \
+/* Iterate over the list and execute a function on each item. Returns 0 on    \
+ * success.                                                                   \
+ */                                                                           \
+int name##_foreach(name##_t *list, void (*f)(T *));                           \
+/* Copy the items of the list to an array of at least size items. Returns 0   \
+ * on success.                                                                \
+ */                                                                           \
+int name##_toarray(name##_t *src, T dest[]);                                  \
+/* Sort the list using a comparison function. Returns 0 on success. */        \
+int name##_sort(name##_t *list, int (*f)(const T *, const T *));              \
+                                                                              \
+/* Get and return the number of items in the list. */                         \
+static inline size_t name##_size(name##_t *list) {                            \
+    return list->size;                                                        \
+}                                                                             \
+                                                                              \
+/* Check if list contains no items. */                                        \
+static inline int name##_isempty(name##_t *list) {                            \
+    return list->size == 0;                                                   \
+}                                                                             \
+                                                                              \
+/* Get and return a pointer to the first item in the list. */                 \
+static inline T *name##_first(name##_t *list) {                               \
+    /* Cannot get from empty list. */                                         \
+    if (list->size == 0) {                                                    \
+        fprintf(stderr, "List is empty\n");                                   \
+        return NULL;                                                          \
+    }                                                                         \
+                                                                              \
+    return &list->head->data;                                                 \
+}                                                                             \
+                                                                              \
+/* Get and return a pointer to the last item in the list. */                  \
+static inline T *name##_last(name##_t *list) {                                \
+    /* Cannot get from empty list. */                                         \
+    if (list->size == 0) {                                                    \
+        fprintf(stderr, "List is empty\n");                                   \
+        return NULL;                                                          \
+    }                                                                         \
+                                                                              \
+    return &list->foot->data;                                                 \
+}                                                                             \
+                                                                              \
+/* Add an item to the end of the list. Returns 0 on success. */               \
+static inline int name##_push(name##_t *list, T data) {                       \
+    name##_node_t *node = (name##_node_t*)malloc(sizeof(name##_node_t));      \
+    if (!node) {                                                              \
+        fprintf(stderr, "Out of memory\n");                                   \
+        return 1;                                                             \
+    }                                                                         \
+                                                                              \
+    /* Initialise node attributes. */                                         \
+    node->next = NULL;                                                        \
+    node->prev = list->foot;                                                  \
+    node->data = data;                                                        \
+                                                                              \
+    /* Add node to list. */                                                   \
+    if (list->size == 0) {                                                    \
+        list->head = node;                                                    \
+    } else {                                                                  \
+        list->foot->next = node;                                              \
+    }                                                                         \
+    list->foot = node;                                                        \
+    list->size++;                                                             \
+    return 0;                                                                 \
+}                                                                             \
+                                                                              \
+/* Remove the item on the end of the list, copying it to data unless data is  \
+ * null. Returns 0 on success.                                                \
+ */                                                                           \
+static inline int name##_pop(name##_t *list, T *data) {                       \
+    name##_node_t *foot = list->foot;                                         \
+                                                                              \
+    /* Cannot pop empty list. */                                              \
+    if (list->size == 0) {                                                    \
+        fprintf(stderr, "List is empty\n");                                   \
+        return 1;                                                             \
+    }                                                                         \
+                                                                              \
+    /* Remove node from list. */                                              \
+    if (data) {                                                               \
+        *data = foot->data;                                                   \
+    }                                                                         \
+    list->foot = foot->prev;                                                  \
+    if (list->foot) {                                                         \
+        list->foot->next = NULL;                                              \
+    } else {                                                                  \
+        list->head = NULL;                                                    \
+    }                                                                         \
+    list->size--;                                                             \
+    free(foot);                                                               \
+    return 0;                                                                 \
+}                                                                             \
+                                                                              \
+/* Add an item to the start of the list. Returns 0 on success. */             \
+static inline int name##_unshift(name##_t *list, T data) {                    \
+    name##_node_t *node = (name##_node_t*)malloc(sizeof(name##_node_t));      \
+    if (!node) {                                                              \
+        fprintf(stderr, "Out of memory\n");                                   \
+        return 1;                                                             \
+    }                                                                         \
+                                                                              \
+    /* Initialise node attributes. */                                         \
+    node->next = list->head;                                                  \
+    node->prev = NULL;                                                        \
+    node->data = data;                                                        \
+                                                                              \
+    /* Add node to list. */                                                   \
+    if (list->size == 0) {                                                    \
+        list->foot = node;                                                    \
+    } else {                                                                  \
+        list->head->prev = node;                                              \
+    }                                                                         \
+    list->head = node;                                                        \
+    list->size++;                                                             \
+    return 0;                                                                 \
+}                                                                             \
+                                                                              \
+/* Remove the item on the start of the list, copying it to data unless data   \
+ * is null. Returns 0 on success.                                             \
+ */                                                                           \
+static inline int name##_shift(name##_t *list, T *data) {                     \
+    name##_node_t *head = list->head;                                         \
+                                                                              \
+    /* Cannot shift empty list. */                                            \
+    if (list->size == 0) {                                                    \
+        fprintf(stderr, "List is empty\n");                                   \
+        return 1;                                                             \
+    }                                                                         \
+                                                                              \
+    /* Remove node from list. */                                              \
+    if (data) {                                                               \
+        *data = head->data;                                                   \
+    }                                                                         \
+    list->head = head->next;                                                  \
+    if (list->head) {                                                         \
+        list->head->prev = NULL;                                              \
+    } else {                                                                  \
+        list->foot = NULL;                                                    \
+    }                                                                         \
+    list->size--;                                                             \
+    free(head);                                                               \
+    return 0;                                                                 \
+}
+
+/* Define the functions of a list type declared with LINKEDLIST_DECLARE(name, T)
+ * which are not inline. Use in one source file only.
+ */
+#define LINKEDLIST_DEFINE(name, T)                                            \
+int name##_create(name##_t *list) {                                           \
+    list->head = list->foot = NULL;                                           \
+    list->size = 0;                                                           \
+    return 0;                                                                 \
+}                                                                             \
+                                                                              \
+int name##_destroy(name##_t *list) {                                          \
+    name##_node_t *curr = list->head, *next;                                  \
+                                                                              \
+    /* Free every node in the list. */                                        \
+    while (curr) {                                                            \
+        next = curr->next;                                                    \
+        free(curr);                                                           \
+        curr = next;                                                          \
+    }                                                                         \
+    return name##_create(list);                                               \
+}                                                                             \
+                                                                              \
+int name##_clone(name##_t *src, name##_t *dest) {                             \
+    name##_node_t *curr;                                                      \
+                                                                              \
+    /* Copy items from src to the end of dest. */                             \
+    name##_create(dest);                                                      \
+    for (curr = src->head; curr; curr = curr->next) {                         \
+        if (name##_push(dest, curr->data)) {                                  \
+            name##_destroy(dest);                                             \
+            return 1;                                                         \
+        }                                                                     \
+    }                                                                         \
+    return 0;                                                                 \
+}                                                                             \
+                                                                              \
+static name##_node_t *name##_nodeat(name##_t *list, size_t index) {           \
+    name##_node_t *curr;                                                      \
+    size_t i;                                                                 \
+                                                                              \
+    /* Walk from whichever end of the list is closer. */                      \
+    if (index < list->size / 2) {                                             \
+        curr = list->head;                                                    \
+        for (i = 0; i < index; i++) {                                         \
+            curr = curr->next;                                                \
+        }                                                                     \
+    } else {                                                                  \
+        curr = list->foot;                                                    \
+        for (i = list->size - 1; i > index; i--) {                            \
+            curr = curr->prev;                                                \
+        }                                                                     \
+    }                                                                         \
+    return curr;                                                              \
+}                                                                             \
+                                                                              \
+int name##_add(name##_t *list, size_t index, T data) {                        \
+    name##_node_t *node, *next;                                               \
+                                                                              \
+    /* Cannot add to index out of range. */                                   \
+    if (index > list->size) {                                                 \
+        fprintf(stderr, "List out of range\n");                               \
+        return 1;                                                             \
+    }                                                                         \
+                                                                              \
+    /* Add to either end of the list. */                                      \
+    if (index == 0) {                                                         \
+        return name##_unshift(list, data);                                    \
+    } else if (index == list->size) {                                         \
+        return name##_push(list, data);                                       \
+    }                                                                         \
+                                                                              \
+    node = (name##_node_t*)malloc(sizeof(name##_node_t));                     \
+    if (!node) {                                                              \
+        fprintf(stderr, "Out of memory\n");                                   \
+        return 1;                                                             \
+    }                                                                         \
+                                                                              \
+    /* Link node in before the node in the specified position. */             \
+    next = name##_nodeat(list, index);                                        \
+    node->next = next;                                                        \
+    node->prev = next->prev;                                                  \
+    node->data = data;                                                        \
+    next->prev->next = node;                                                  \
+    next->prev = node;                                                        \
+    list->size++;                                                             \
+    return 0;                                                                 \
+}                                                                             \
+                                                                              \
+int name##_remove(name##_t *list, size_t index, T *data) {                    \
+    name##_node_t *node;                                                      \
+                                                                              \
+    /* Cannot remove from index out of range. */                              \
+    if (index >= list->size) {                                                \
+        fprintf(stderr, "List out of range\n");                               \
+        return 1;                                                             \
+    }                                                                         \
+                                                                              \
+    /* Remove from either end of the list. */                                 \
+    if (index == 0) {                                                         \
+        return name##_shift(list, data);                                      \
+    } else if (index == list->size - 1) {                                     \
+        return name##_pop(list, data);                                        \
+    }                                                                         \
+                                                                              \
+    /* Unlink node from the middle of the list. */                            \
+    node = name##_nodeat(list, index);                                        \
+    if (data) {                                                               \
+        *data = node->data;                                                   \
+    }                                                                         \
+    node->prev->next = node->next;                                            \
+    node->next->prev = node->prev;                                            \
+    list->size--;                                                             \
+    free(node);                                                               \
+    return 0;                                                                 \
+}                                                                             \
+                                                                              \
+int name##_set(name##_t *list, size_t index, T data) {                        \
+    /* Cannot set index out of range. */                                      \
+    if (index >= list->size) {                                                \
+        fprintf(stderr, "List out of range\n");                               \
+        return 1;                                                             \
+    }                                                                         \
+                                                                              \
+    name##_nodeat(list, index)->data = data;                                  \
+    return 0;                                                                 \
+}                                                                             \
+                                                                              \
+T *name##_get(name##_t *list, size_t index) {                                 \
+    /* Cannot get index out of range. */                                      \
+    if (index >= list->size) {                                                \
+        fprintf(stderr, "List out of range\n");                               \
+        return NULL;                                                          \
+    }                                                                         \
+                                                                              \
+    return &name##_nodeat(list, index)->data;                                 \
+}                                                                             \
+                                                                              \
+T *name##_find(name##_t *list, int (*f)(const T *)) {                         \
+    name##_node_t *curr;                                                      \
+                                                                              \
+    for (curr = list->head; curr; curr = curr->next) {                        \
+        if (f(&curr->data) == 1) {                                            \
+            return &curr->data;                                               \
+        }                                                                     \
+    }                                                                         \
+    return NULL;                                                              \
+}                                                                             \
+                                                                              \
+size_t name##_findindex(name##_t *list, int (*f)(const T *)) {                \
+    name##_node_t *curr;                                                      \
+    size_t i = 0;                                                             \
+                                                                              \
+    for (curr = list->head; curr; curr = curr->next) {                        \
+        if (f(&curr->data) == 1) {                                            \
+            break;                                                            \
+        }                                                                     \
+        i++;                                                                  \
+    }                                                                         \
+    return i;                                                                 \
+}                                                                             \
+                                                                              \
+int name##_foreach(name##_t *list, void (*f)(T *)) {                          \
+    name##_node_t *curr;                                                      \
+                                                                              \
+    for (curr = list->head; curr; curr = curr->next) {                        \
+        f(&curr->data);                                                       \
+    }                                                                         \
+    return 0;                                                                 \
+}                                                                             \
+                                                                              \
+int name##_toarray(name##_t *src, T dest[]) {                                 \
+    name##_node_t *curr;                                                      \
+    size_t i = 0;                                                             \
+                                                                              \
+    for (curr = src->head; curr; curr = curr->next) {                         \
+        dest[i++] = curr->data;                                               \
+    }                                                                         \
+    return 0;                                                                 \
+}                                                                             \
+                                                                              \
+static name##_node_t *name##_merge(name##_node_t *a, name##_node_t *b,        \
+    int (*f)(const T *, const T *)) {                                         \
+    name##_node_t head, *tail = &head;                                        \
+                                                                              \
+    /* Merge two sorted chains, taking from a first on ties. */               \
+    while (a && b) {                                                          \
+        if (f(&a->data, &b->data) <= 0) {                                     \
+            tail->next = a;                                                   \
+            a = a->next;                                                      \
+        } else {                                                              \
+            tail->next = b;                                                   \
+            b = b->next;                                                      \
+        }                                                                     \
+        tail = tail->next;                                                    \
+    }                                                                         \
+    tail->next = a ? a : b;                                                   \
+    return head.next;                                                         \
+}                                                                             \
+                                                                              \
+int name##_sort(name##_t *list, int (*f)(const T *, const T *)) {             \
+    name##_node_t *runs[sizeof(size_t) * 8] = { NULL };                       \
+    name##_node_t *curr = list->head, *run, *prev;                            \
+    size_t i, nruns = 0;                                                      \
+                                                                              \
+    /* Merge single nodes into runs of doubling lengths. */                   \
+    while (curr) {                                                            \
+        run = curr;                                                           \
+        curr = curr->next;                                                    \
+        run->next = NULL;                                                     \
+        for (i = 0; runs[i]; i++) {                                           \
+            run = name##_merge(runs[i], run, f);                              \
+            runs[i] = NULL;                                                   \
+        }                                                                     \
+        runs[i] = run;                                                        \
+        if (i >= nruns) {                                                     \
+            nruns = i + 1;                                                    \
+        }                                                                     \
+    }                                                                         \
+                                                                              \
+    /* Merge the remaining runs, earlier items being in later runs. */        \
+    run = NULL;                                                               \
+    for (i = 0; i < nruns; i++) {                                             \
+        if (runs[i]) {                                                        \
+            run = run ? name##_merge(runs[i], run, f) : runs[i];              \
+        }                                                                     \
+    }                                                                         \
+                                                                              \
+    /* Relink prev pointers and assign new list head and foot. */             \
+    list->head = run;                                                         \
+    prev = NULL;                                                              \
+    for (curr = run; curr; curr = curr->next) {                               \
+        curr->prev = prev;                                                    \
+        prev = curr;                                                          \
+    }                                                                         \
+    list->foot = prev;                                                        \
+    return 0;                                                                 \
+}
+
+#endif
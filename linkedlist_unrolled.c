@@ -0,0 +1,757 @@
+/*
+ * linkedlist_unrolled.c
+ * Version 20261018
+ * Written by Harry Wong (RedAndBlueEraser)
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include "linkedlist_unrolled.h"
+
+#define CAPACITY LINKEDLIST_UNROLLED_CAPACITY
+
+typedef struct linkedlist_unrolled_tally_t {
+    void *data;
+    size_t count;
+} linkedlist_unrolled_tally_t;
+
+static linkedlist_unrolled_node_t *linkedlist_unrolled_node_alloc(void) {
+    linkedlist_unrolled_node_t *node;
+
+    /* Align nodes to cache lines where the C library allows it. */
+#if defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L
+    node = (linkedlist_unrolled_node_t*)aligned_alloc(64,
+        (sizeof *node + 63) / 64 * 64);
+#else
+    node = (linkedlist_unrolled_node_t*)malloc(sizeof *node);
+#endif
+    if (!node) {
+        fprintf(stderr, "Out of memory\n");
+        return NULL;
+    }
+    node->next = node->prev = NULL;
+    node->count = 0;
+    return node;
+}
+
+static void linkedlist_unrolled_link(linkedlist_unrolled_t *list,
+    linkedlist_unrolled_node_t *prev, linkedlist_unrolled_node_t *node) {
+    /* Add node to list after prev (or at the start if prev is null). */
+    node->prev = prev;
+    node->next = prev ? prev->next : list->head;
+    if (node->next) {
+        node->next->prev = node;
+    } else {
+        list->foot = node;
+    }
+    if (prev) {
+        prev->next = node;
+    } else {
+        list->head = node;
+    }
+}
+
+static void linkedlist_unrolled_unlink(linkedlist_unrolled_t *list,
+    linkedlist_unrolled_node_t *node) {
+    /* Remove node from list and free it. */
+    if (node->prev) {
+        node->prev->next = node->next;
+    } else {
+        list->head = node->next;
+    }
+    if (node->next) {
+        node->next->prev = node->prev;
+    } else {
+        list->foot = node->prev;
+    }
+    free(node);
+}
+
+static linkedlist_unrolled_node_t *linkedlist_unrolled_locate(
+    linkedlist_unrolled_t *list, size_t *index) {
+    linkedlist_unrolled_node_t *curr;
+    size_t remaining;
+
+    /* Iterate until the node holding index from whichever end is closer, and
+     * turn index into the position within that node.
+     */
+    if (*index < list->size / 2) {
+        curr = list->head;
+        while (*index >= curr->count) {
+            *index -= curr->count;
+            curr = curr->next;
+        }
+    } else {
+        curr = list->foot;
+        remaining = list->size - *index;
+        while (remaining > curr->count) {
+            remaining -= curr->count;
+            curr = curr->prev;
+        }
+        *index = curr->count - remaining;
+    }
+    return curr;
+}
+
+static int linkedlist_unrolled_insert(linkedlist_unrolled_t *list,
+    linkedlist_unrolled_node_t *node, size_t offset, void *data) {
+    linkedlist_unrolled_node_t *split;
+    size_t half;
+
+    /* Split a full node in half. */
+    if (node->count == CAPACITY) {
+        split = linkedlist_unrolled_node_alloc();
+        if (!split) {
+            return 1;
+        }
+        half = CAPACITY / 2;
+        memcpy(split->data, node->data + half,
+            sizeof node->data[0] * (CAPACITY - half));
+        split->count = CAPACITY - half;
+        node->count = half;
+        linkedlist_unrolled_link(list, node, split);
+        if (offset > half) {
+            node = split;
+            offset -= half;
+        }
+    }
+
+    /* Add item to node. */
+    memmove(node->data + offset + 1, node->data + offset,
+        sizeof node->data[0] * (node->count - offset));
+    node->data[offset] = data;
+    node->count++;
+    list->size++;
+    return 0;
+}
+
+static void linkedlist_unrolled_merge(linkedlist_unrolled_t *list,
+    linkedlist_unrolled_node_t *node) {
+    linkedlist_unrolled_node_t *next = node->next;
+
+    /* Merge node with the next node once both fit in one node. */
+    if (node->count >= CAPACITY / 2 || !next
+        || node->count + next->count > CAPACITY) {
+        return;
+    }
+    memcpy(node->data + node->count, next->data,
+        sizeof next->data[0] * next->count);
+    node->count += next->count;
+    linkedlist_unrolled_unlink(list, next);
+}
+
+static int linkedlist_unrolled_compare(const void *a, const void *b) {
+    uintptr_t x = (uintptr_t)((const linkedlist_unrolled_tally_t*)a)->data;
+    uintptr_t y = (uintptr_t)((const linkedlist_unrolled_tally_t*)b)->data;
+    return x < y ? -1 : x > y;
+}
+
+static void linkedlist_unrolled_removetallied(linkedlist_unrolled_t *list,
+    linkedlist_unrolled_tally_t *table, size_t count, int all) {
+    linkedlist_unrolled_node_t *curr, *next;
+    linkedlist_unrolled_tally_t key, *entry;
+    size_t i, kept, unique = 0;
+
+    /* Sort the tally by item, counting each item once. */
+    qsort(table, count, sizeof *table, linkedlist_unrolled_compare);
+    for (i = 0; i < count; i++) {
+        if (unique > 0 && table[unique - 1].data == table[i].data) {
+            table[unique - 1].count++;
+        } else {
+            table[unique++] = table[i];
+        }
+    }
+
+    /* Remove tallied items, only as many times as tallied unless all, moving
+     * the kept items of each node together.
+     */
+    for (curr = list->head; curr; curr = next) {
+        next = curr->next;
+        kept = 0;
+        for (i = 0; i < curr->count; i++) {
+            key.data = curr->data[i];
+            entry = (linkedlist_unrolled_tally_t*)bsearch(&key, table, unique,
+                sizeof *table, linkedlist_unrolled_compare);
+            if (entry && entry->count > 0) {
+                if (!all) {
+                    entry->count--;
+                }
+                list->size--;
+            } else {
+                curr->data[kept++] = curr->data[i];
+            }
+        }
+        curr->count = kept;
+        if (kept == 0) {
+            linkedlist_unrolled_unlink(list, curr);
+        }
+    }
+
+    /* Merge sparse nodes with their neighbours. */
+    for (curr = list->head; curr; curr = curr->next) {
+        linkedlist_unrolled_merge(list, curr);
+    }
+}
+
+static int linkedlist_unrolled_removearraytallied(
+    linkedlist_unrolled_t *dest, void *src[], int all) {
+    linkedlist_unrolled_tally_t *table;
+    size_t i, count;
+
+    /* Count items in src. */
+    for (count = 0; src[count]; count++) {
+    }
+    if (dest->size == 0 || count == 0) {
+        return 0;
+    }
+
+    /* Tally items from src, then remove them from dest in one pass. */
+    table = (linkedlist_unrolled_tally_t*)malloc(count * sizeof *table);
+    if (!table) {
+        fprintf(stderr, "Out of memory\n");
+        return 1;
+    }
+    for (i = 0; i < count; i++) {
+        table[i].data = src[i];
+        table[i].count = 1;
+    }
+    linkedlist_unrolled_removetallied(dest, table, count, all);
+    free(table);
+    return 0;
+}
+
+static int linkedlist_unrolled_removelinkedlisttallied(
+    linkedlist_unrolled_t *dest, linkedlist_unrolled_t *src, int all) {
+    linkedlist_unrolled_tally_t *table;
+    linkedlist_unrolled_node_t *srccurr;
+    size_t i, count = 0;
+
+    if (dest->size == 0 || src->size == 0) {
+        return 0;
+    }
+
+    /* Tally items from src, then remove them from dest in one pass. */
+    table = (linkedlist_unrolled_tally_t*)malloc(src->size * sizeof *table);
+    if (!table) {
+        fprintf(stderr, "Out of memory\n");
+        return 1;
+    }
+    for (srccurr = src->head; srccurr; srccurr = srccurr->next) {
+        for (i = 0; i < srccurr->count; i++) {
+            table[count].data = srccurr->data[i];
+            table[count++].count = 1;
+        }
+    }
+    linkedlist_unrolled_removetallied(dest, table, count, all);
+    free(table);
+    return 0;
+}
+
+
+int linkedlist_unrolled_create(linkedlist_unrolled_t *list) {
+    /* Initialise list attributes. */
+    list->head = list->foot = NULL;
+    list->size = 0;
+    return 0;
+}
+
+int linkedlist_unrolled_destroy(linkedlist_unrolled_t *list) {
+    /* Free memory allocated for nodes in the list. */
+    linkedlist_unrolled_node_t *curr = list->head, *next;
+    while (curr) {
+        next = curr->next;
+        free(curr);
+        curr = next;
+    }
+
+    /* Create a new empty list. */
+    return linkedlist_unrolled_create(list);
+}
+
+int linkedlist_unrolled_clone(linkedlist_unrolled_t *src,
+    linkedlist_unrolled_t *dest) {
+    linkedlist_unrolled_node_t *srccurr = src->head, *destcurr;
+
+    /* Create a new empty list for dest. */
+    linkedlist_unrolled_create(dest);
+
+    /* Copy nodes from src to dest. */
+    while (srccurr) {
+        destcurr = linkedlist_unrolled_node_alloc();
+        if (!destcurr) {
+            linkedlist_unrolled_destroy(dest);
+            return 1;
+        }
+        memcpy(destcurr->data, srccurr->data,
+            sizeof srccurr->data[0] * srccurr->count);
+        destcurr->count = srccurr->count;
+        linkedlist_unrolled_link(dest, dest->foot, destcurr);
+        srccurr = srccurr->next;
+    }
+    dest->size = src->size;
+    return 0;
+}
+
+
+size_t linkedlist_unrolled_size(linkedlist_unrolled_t *list) {
+    return list->size;
+}
+
+int linkedlist_unrolled_isempty(linkedlist_unrolled_t *list) {
+    return list->size == 0;
+}
+
+
+int linkedlist_unrolled_push(linkedlist_unrolled_t *list, void *data) {
+    linkedlist_unrolled_node_t *node = list->foot;
+
+    /* Add a new node to the end of the list once the last node is full. */
+    if (!node || node->count == CAPACITY) {
+        node = linkedlist_unrolled_node_alloc();
+        if (!node) {
+            return 1;
+        }
+        linkedlist_unrolled_link(list, list->foot, node);
+    }
+
+    /* Add item to node. */
+    node->data[node->count++] = data;
+    list->size++;
+    return 0;
+}
+
+void *linkedlist_unrolled_pop(linkedlist_unrolled_t *list) {
+    void *data;
+    linkedlist_unrolled_node_t *foot = list->foot;
+
+    /* Cannot pop empty list. */
+    if (list->size == 0) {
+        fprintf(stderr, "List is empty\n");
+        return NULL;
+    }
+
+    /* Remove item from the last node. */
+    data = foot->data[--foot->count];
+    if (foot->count == 0) {
+        linkedlist_unrolled_unlink(list, foot);
+    }
+    list->size--;
+    return data;
+}
+
+int linkedlist_unrolled_unshift(linkedlist_unrolled_t *list, void *data) {
+    linkedlist_unrolled_node_t *node = list->head;
+
+    /* Add a new node to the start of the list once the first node is full. */
+    if (!node || node->count == CAPACITY) {
+        node = linkedlist_unrolled_node_alloc();
+        if (!node) {
+            return 1;
+        }
+        linkedlist_unrolled_link(list, NULL, node);
+    }
+    return linkedlist_unrolled_insert(list, node, 0, data);
+}
+
+void *linkedlist_unrolled_shift(linkedlist_unrolled_t *list) {
+    void *data;
+    linkedlist_unrolled_node_t *head = list->head;
+
+    /* Cannot shift empty list. */
+    if (list->size == 0) {
+        fprintf(stderr, "List is empty\n");
+        return NULL;
+    }
+
+    /* Remove item from the first node. */
+    data = head->data[0];
+    head->count--;
+    if (head->count == 0) {
+        linkedlist_unrolled_unlink(list, head);
+    } else {
+        memmove(head->data, head->data + 1,
+            sizeof head->data[0] * head->count);
+    }
+    list->size--;
+    return data;
+}
+
+int linkedlist_unrolled_add(linkedlist_unrolled_t *list, size_t index,
+    void *data) {
+    linkedlist_unrolled_node_t *node;
+
+    /* Cannot add to index beyond list size. */
+    if (index > list->size) {
+        fprintf(stderr, "List out of range\n");
+        return 1;
+    }
+
+    if (index == list->size) {
+        return linkedlist_unrolled_push(list, data);
+    }
+
+    /* Prefer adding to the end of the previous node over moving items. */
+    node = linkedlist_unrolled_locate(list, &index);
+    if (index == 0 && node->prev && node->prev->count < CAPACITY) {
+        node = node->prev;
+        index = node->count;
+    }
+    return linkedlist_unrolled_insert(list, node, index, data);
+}
+
+void *linkedlist_unrolled_remove(linkedlist_unrolled_t *list, size_t index) {
+    void *data;
+    linkedlist_unrolled_node_t *node;
+
+    /* Cannot remove from empty list. */
+    if (list->size == 0) {
+        fprintf(stderr, "List is empty\n");
+        return NULL;
+    }
+
+    /* Cannot remove from index beyond list size. */
+    if (index >= list->size) {
+        fprintf(stderr, "List out of range\n");
+        return NULL;
+    }
+
+    /* Remove item from node. */
+    node = linkedlist_unrolled_locate(list, &index);
+    data = node->data[index];
+    node->count--;
+    memmove(node->data + index, node->data + index + 1,
+        sizeof node->data[0] * (node->count - index));
+    list->size--;
+
+    /* Free an empty node, otherwise merge a sparse node with a neighbour. */
+    if (node->count == 0) {
+        linkedlist_unrolled_unlink(list, node);
+    } else if (node->next) {
+        linkedlist_unrolled_merge(list, node);
+    } else if (node->prev && node->prev->count < CAPACITY / 2) {
+        linkedlist_unrolled_merge(list, node->prev);
+    }
+    return data;
+}
+
+int linkedlist_unrolled_set(linkedlist_unrolled_t *list, size_t index,
+    void *data) {
+    linkedlist_unrolled_node_t *node;
+
+    /* Cannot set in empty list. */
+    if (list->size == 0) {
+        fprintf(stderr, "List is empty\n");
+        return 1;
+    }
+
+    /* Cannot set from index beyond list size. */
+    if (index >= list->size) {
+        fprintf(stderr, "List out of range\n");
+        return 1;
+    }
+
+    node = linkedlist_unrolled_locate(list, &index);
+    node->data[index] = data;
+    return 0;
+}
+
+int linkedlist_unrolled_addarray(linkedlist_unrolled_t *dest, void *src[]) {
+    void *data;
+    size_t i = 0;
+
+    /* Add items from src to dest. */
+    while ((data = src[i++])) {
+        if (linkedlist_unrolled_push(dest, data) != 0) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+int linkedlist_unrolled_removearray(linkedlist_unrolled_t *dest,
+    void *src[]) {
+    return linkedlist_unrolled_removearraytallied(dest, src, 0);
+}
+
+int linkedlist_unrolled_removearrayall(linkedlist_unrolled_t *dest,
+    void *src[]) {
+    return linkedlist_unrolled_removearraytallied(dest, src, 1);
+}
+
+int linkedlist_unrolled_addlinkedlist(linkedlist_unrolled_t *dest,
+    linkedlist_unrolled_t *src) {
+    linkedlist_unrolled_node_t *srccurr = src->head;
+    size_t i, size = src->size;
+
+    /* Add items from src to dest, stopping at the items src started with in
+     * case src is dest.
+     */
+    while (size > 0) {
+        for (i = 0; i < srccurr->count && size > 0; i++, size--) {
+            if (linkedlist_unrolled_push(dest, srccurr->data[i]) != 0) {
+                return 1;
+            }
+        }
+        srccurr = srccurr->next;
+    }
+    return 0;
+}
+
+int linkedlist_unrolled_removelinkedlist(linkedlist_unrolled_t *dest,
+    linkedlist_unrolled_t *src) {
+    return linkedlist_unrolled_removelinkedlisttallied(dest, src, 0);
+}
+
+int linkedlist_unrolled_removelinkedlistall(linkedlist_unrolled_t *dest,
+    linkedlist_unrolled_t *src) {
+    return linkedlist_unrolled_removelinkedlisttallied(dest, src, 1);
+}
+
+
+void *linkedlist_unrolled_get(linkedlist_unrolled_t *list, size_t index) {
+    linkedlist_unrolled_node_t *node;
+
+    /* Cannot get from empty list. */
+    if (list->size == 0) {
+        fprintf(stderr, "List is empty\n");
+        return NULL;
+    }
+
+    /* Cannot get from index beyond list size. */
+    if (index >= list->size) {
+        fprintf(stderr, "List out of range\n");
+        return NULL;
+    }
+
+    node = linkedlist_unrolled_locate(list, &index);
+    return node->data[index];
+}
+
+void *linkedlist_unrolled_first(linkedlist_unrolled_t *list) {
+    /* Cannot get from empty list. */
+    if (list->size == 0) {
+        fprintf(stderr, "List is empty\n");
+        return NULL;
+    }
+
+    return list->head->data[0];
+}
+
+void *linkedlist_unrolled_last(linkedlist_unrolled_t *list) {
+    /* Cannot get from empty list. */
+    if (list->size == 0) {
+        fprintf(stderr, "List is empty\n");
+        return NULL;
+    }
+
+    return list->foot->data[list->foot->count - 1];
+}
+
+size_t linkedlist_unrolled_indexof(linkedlist_unrolled_t *list, void *data) {
+    linkedlist_unrolled_node_t *curr = list->head;
+    size_t i, index = 0;
+
+    /* Test each item until an item passes the test. */
+    while (curr) {
+        for (i = 0; i < curr->count; i++) {
+            if (curr->data[i] == data) {
+                return index + i;
+            }
+        }
+        index += curr->count;
+        curr = curr->next;
+    }
+    return index;
+}
+
+void *linkedlist_unrolled_find(linkedlist_unrolled_t *list,
+    int (*f)(void *)) {
+    linkedlist_unrolled_node_t *curr = list->head;
+    size_t i;
+
+    /* Test each item until an item passes the test. */
+    while (curr) {
+        for (i = 0; i < curr->count; i++) {
+            if (f(curr->data[i]) == 1) {
+                return curr->data[i];
+            }
+        }
+        curr = curr->next;
+    }
+    return NULL;
+}
+
+size_t linkedlist_unrolled_findindex(linkedlist_unrolled_t *list,
+    int (*f)(void *)) {
+    linkedlist_unrolled_node_t *curr = list->head;
+    size_t i, index = 0;
+
+    /* Test each item until an item passes the test. */
+    while (curr) {
+        for (i = 0; i < curr->count; i++) {
+            if (f(curr->data[i]) == 1) {
+                return index + i;
+            }
+        }
+        index += curr->count;
+        curr = curr->next;
+    }
+    return index;
+}
+
+int linkedlist_unrolled_foreach(linkedlist_unrolled_t *list,
+    void (*f)(void *)) {
+    linkedlist_unrolled_node_t *curr = list->head;
+    size_t i;
+
+    /* Execute function on every item. */
+    while (curr) {
+        for (i = 0; i < curr->count; i++) {
+            f(curr->data[i]);
+        }
+        curr = curr->next;
+    }
+    return 0;
+}
+
+
+int linkedlist_unrolled_slice(linkedlist_unrolled_t *list, size_t start,
+    size_t end) {
+    linkedlist_unrolled_node_t *node;
+    size_t offset;
+
+    /* Slice to empty list. */
+    if (start >= end || start >= list->size) {
+        return linkedlist_unrolled_destroy(list);
+    }
+    /* Slice to end of list. */
+    if (end > list->size) {
+        end = list->size;
+    }
+
+    /* Free items from end onwards. */
+    if (end < list->size) {
+        offset = end;
+        node = linkedlist_unrolled_locate(list, &offset);
+        while (node->next) {
+            linkedlist_unrolled_unlink(list, node->next);
+        }
+        node->count = offset;
+        if (node->count == 0) {
+            linkedlist_unrolled_unlink(list, node);
+        }
+        list->size = end;
+    }
+
+    /* Free items before start. */
+    if (start > 0) {
+        offset = start;
+        node = linkedlist_unrolled_locate(list, &offset);
+        while (node->prev) {
+            linkedlist_unrolled_unlink(list, node->prev);
+        }
+        node->count -= offset;
+        memmove(node->data, node->data + offset,
+            sizeof node->data[0] * node->count);
+        list->size -= start;
+    }
+
+    /* Merge sparse nodes at either end with their neighbours. */
+    linkedlist_unrolled_merge(list, list->head);
+    if (list->foot->prev) {
+        linkedlist_unrolled_merge(list, list->foot->prev);
+    }
+    return 0;
+}
+
+int linkedlist_unrolled_toarray(linkedlist_unrolled_t *src, void *dest[]) {
+    linkedlist_unrolled_node_t *curr = src->head;
+    size_t index = 0;
+
+    /* Copies each item from the list to the array. */
+    while (curr) {
+        memcpy(dest + index, curr->data, sizeof curr->data[0] * curr->count);
+        index += curr->count;
+        curr = curr->next;
+    }
+    dest[index] = NULL;
+    return 0;
+}
+
+int linkedlist_unrolled_reverse(linkedlist_unrolled_t *list) {
+    linkedlist_unrolled_node_t *curr = list->head, *next;
+    void *data;
+    size_t i;
+
+    /* Swap the links of every node and reverse the items within it. */
+    while (curr) {
+        next = curr->next;
+        curr->next = curr->prev;
+        curr->prev = next;
+        for (i = 0; i < curr->count / 2; i++) {
+            data = curr->data[i];
+            curr->data[i] = curr->data[curr->count - 1 - i];
+            curr->data[curr->count - 1 - i] = data;
+        }
+        curr = next;
+    }
+
+    /* Swap list head and foot. */
+    curr = list->head;
+    list->head = list->foot;
+    list->foot = curr;
+    return 0;
+}
+
+int linkedlist_unrolled_sort(linkedlist_unrolled_t *list,
+    int (*f)(const void *, const void *)) {
+    linkedlist_unrolled_node_t *curr;
+    void **items, **sorted, **swap;
+    size_t width, start, middle, end, i, j, k;
+
+    if (list->size < 2) {
+        return 0;
+    }
+    items = (void**)malloc(2 * list->size * sizeof *items);
+    if (!items) {
+        fprintf(stderr, "Out of memory\n");
+        return 1;
+    }
+    sorted = items + list->size;
+
+    /* Copy items into the array. */
+    for (curr = list->head, k = 0; curr; curr = curr->next) {
+        memcpy(items + k, curr->data, sizeof curr->data[0] * curr->count);
+        k += curr->count;
+    }
+
+    /* Merge runs of doubling width back and forth between the halves of the
+     * array, taking from the first run on ties to keep equal items in order.
+     */
+    for (width = 1; width < list->size; width *= 2) {
+        for (start = 0; start < list->size; start += 2 * width) {
+            middle = start + width < list->size ? start + width : list->size;
+            end = middle + width < list->size ? middle + width : list->size;
+            for (i = start, j = middle, k = start; k < end; k++) {
+                if (i < middle && (j == end || f(&items[i], &items[j]) <= 0)) {
+                    sorted[k] = items[i++];
+                } else {
+                    sorted[k] = items[j++];
+                }
+            }
+        }
+        swap = items;
+        items = sorted;
+        sorted = swap;
+    }
+
+    /* Copy sorted items back into the nodes. */
+    for (curr = list->head, k = 0; curr; curr = curr->next) {
+        memcpy(curr->data, items + k, sizeof curr->data[0] * curr->count);
+        k += curr->count;
+    }
+    free(items < sorted ? items : sorted);
+    return 0;
+}
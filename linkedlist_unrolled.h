@@ -0,0 +1,132 @@
+/*
+ * linkedlist_unrolled.h
+ * Version 20261018
+ * Written by Harry Wong (RedAndBlueEraser)
+ */
+
+#ifndef LINKEDLIST_UNROLLED_H
+#define LINKEDLIST_UNROLLED_H
+
+#include <stddef.h>
+
+/* Number of items held by each node. The default sizes a node to two 64 byte
+ * cache lines.
+ */
+#ifndef LINKEDLIST_UNROLLED_CAPACITY
+#define LINKEDLIST_UNROLLED_CAPACITY 13
+#endif
+
+typedef struct linkedlist_unrolled_node_t {
+    struct linkedlist_unrolled_node_t *next;
+    struct linkedlist_unrolled_node_t *prev;
+    size_t count;
+    void *data[LINKEDLIST_UNROLLED_CAPACITY];
+} linkedlist_unrolled_node_t;
+
+typedef struct linkedlist_unrolled_t {
+    linkedlist_unrolled_node_t *head;
+    linkedlist_unrolled_node_t *foot;
+    size_t size;
+} linkedlist_unrolled_t;
+
+/* Create a new empty list. Returns 0 on success. */
+int linkedlist_unrolled_create(linkedlist_unrolled_t *list);
+/* Empty the list. Returns 0 on success. */
+int linkedlist_unrolled_destroy(linkedlist_unrolled_t *list);
+/* Copies a list. */
+int linkedlist_unrolled_clone(linkedlist_unrolled_t *src,
+    linkedlist_unrolled_t *dest);
+
+/* Get and return the number of items in the list. */
+size_t linkedlist_unrolled_size(linkedlist_unrolled_t *list);
+/* Check if list contains no items. */
+int linkedlist_unrolled_isempty(linkedlist_unrolled_t *list);
+
+/* Add an item to the end of the list. Returns 0 on success. */
+int linkedlist_unrolled_push(linkedlist_unrolled_t *list, void *data);
+/* Remove and return the item on the end of the list. */
+void *linkedlist_unrolled_pop(linkedlist_unrolled_t *list);
+/* Add an item to the start of the list. Returns 0 on success. */
+int linkedlist_unrolled_unshift(linkedlist_unrolled_t *list, void *data);
+/* Remove and return the item on the start of the list. */
+void *linkedlist_unrolled_shift(linkedlist_unrolled_t *list);
+/* Add an item to the specified position in the list. Returns 0 on success. */
+int linkedlist_unrolled_add(linkedlist_unrolled_t *list, size_t index,
+    void *data);
+/* Remove and return the item in the specified position of the list. */
+void *linkedlist_unrolled_remove(linkedlist_unrolled_t *list, size_t index);
+/* Replace an item in the specified position of the list. Returns 0 on success.
+ */
+int linkedlist_unrolled_set(linkedlist_unrolled_t *list, size_t index,
+    void *data);
+/* Add the items from the null-terminated array to the end of the list. Returns
+ * 0 on success.
+ */
+int linkedlist_unrolled_addarray(linkedlist_unrolled_t *dest, void *src[]);
+/* Remove the items in the null-terminated array from the list. Returns 0 on
+ * success.
+ */
+int linkedlist_unrolled_removearray(linkedlist_unrolled_t *dest,
+    void *src[]);
+/* Remove every occurrence of the items in the null-terminated array from the
+ * list. Returns 0 on success.
+ */
+int linkedlist_unrolled_removearrayall(linkedlist_unrolled_t *dest,
+    void *src[]);
+/* Add the items from the src list to the end of the dest list. Returns 0 on
+ * success.
+ */
+int linkedlist_unrolled_addlinkedlist(linkedlist_unrolled_t *dest,
+    linkedlist_unrolled_t *src);
+/* Remove the items in the src list from the dest list. Returns 0 on success. */
+int linkedlist_unrolled_removelinkedlist(linkedlist_unrolled_t *dest,
+    linkedlist_unrolled_t *src);
+/* Remove every occurrence of the items in the src list from the dest list.
+ * Returns 0 on success.
+ */
+int linkedlist_unrolled_removelinkedlistall(linkedlist_unrolled_t *dest,
+    linkedlist_unrolled_t *src);
+
+/* Get and return the item in the specified position in the list. */
+void *linkedlist_unrolled_get(linkedlist_unrolled_t *list, size_t index);
+/* Get and return the first item in the list. */
+void *linkedlist_unrolled_first(linkedlist_unrolled_t *list);
+/* Get and return the last item in the list. */
+void *linkedlist_unrolled_last(linkedlist_unrolled_t *list);
+/* Find and return the index of the specified item in the list. Returns the
+ * number of items in the list if the item is not found.
+ */
+size_t linkedlist_unrolled_indexof(linkedlist_unrolled_t *list, void *data);
+/* Find and return the first item in the list that pass the test (provided as a
+ * function where a pass is 1). Returns null if no items pass the test.
+ */
+void *linkedlist_unrolled_find(linkedlist_unrolled_t *list,
+    int (*f)(void *));
+/* Find and return the index of the first item in the list that pass the test
+ * (provided as a function where a pass is 1). Returns the number of items in
+ * the list if no items pass the test.
+ */
+size_t linkedlist_unrolled_findindex(linkedlist_unrolled_t *list,
+    int (*f)(void *));
+/* Iterate over the list and execute a function on each item. Returns 0 on
+ * success.
+ */
+int linkedlist_unrolled_foreach(linkedlist_unrolled_t *list,
+    void (*f)(void *));
+
+/* Slice the list from including start to excluding end. Returns 0 on
+ * success.
+ */
+int linkedlist_unrolled_slice(linkedlist_unrolled_t *list, size_t start,
+    size_t end);
+/* Represents the list as a null-terminated array. Returns 0 on success. */
+int linkedlist_unrolled_toarray(linkedlist_unrolled_t *src, void *dest[]);
+/* Reverse the order of items in the list. Returns 0 on success. */
+int linkedlist_unrolled_reverse(linkedlist_unrolled_t *list);
+/* Sort the items in the list, keeping the order of equal items. Returns 0 on
+ * success.
+ */
+int linkedlist_unrolled_sort(linkedlist_unrolled_t *list,
+    int (*f)(const void *, const void *));
+
+#endif
@@ -1,19 +1,26 @@
 /*
  * main.c
- * Version 20160927
+ * Version 20261018
  * Written by Harry Wong (RedAndBlueEraser)
  */
 
 #include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
 #include "linkedlist.h"
 
 int linkedlist_printint(linkedlist_t *list) {
-    int i, ret = printf("[");
-    if (!linkedlist_isempty(list)) {
-        ret += printf("%d", (int)linkedlist_get(list, 0));
+    linkedlist_cursor_t cursor;
+    int ret = printf("[");
+    linkedlist_cursor_begin(list, &cursor);
+    if (!linkedlist_cursor_isend(&cursor)) {
+        ret += printf("%d", (int)(intptr_t)linkedlist_cursor_get(&cursor));
+        linkedlist_cursor_next(&cursor);
     }
-    for (i = 1; i < linkedlist_size(list); i++) {
-        ret += printf(", %d", (int)linkedlist_get(list, i));
+    while (!linkedlist_cursor_isend(&cursor)) {
+        ret += printf(", %d", (int)(intptr_t)linkedlist_cursor_get(&cursor));
+        linkedlist_cursor_next(&cursor);
     }
     ret += printf("] (n = %zd) @%p", linkedlist_size(list), list);
     return ret;
@@ -37,6 +44,20 @@ void testprint(void *data) {
 int testsortcmpfn(const void *a, const void *b) {
     return (*(int*)a - *(int*)b);
 }
+size_t testencode(void *data, void *buffer, size_t size) {
+    char string[16];
+    size_t length = (size_t)sprintf(string, "%d", (int)data);
+    if (length <= size) {
+        memcpy(buffer, string, length);
+    }
+    return length;
+}
+int testdecode(const void *buffer, size_t size, void **data) {
+    char string[16] = { 0 };
+    memcpy(string, buffer, size < 15 ? size : 15);
+    *data = (void *)atoi(string);
+    return 0;
+}
 
 int main(int argc, char *argv[]) {
     linkedlist_t l1, *list1 = &l1, l2, *list2 = &l2;
@@ -213,5 +234,48 @@ int main(int argc, char *argv[]) {
     printf(" list1 sorted\n"); linkedlist_sort(list1, testsortcmpfn);
     printf(" list1 "); linkedlist_printint(list1); printf("\n");
     printf(" list1 destroyed\n"); linkedlist_destroy(list1);
+
+    printf(" --------\n");
+
+    printf(" list1 added array with array3\n"); linkedlist_addarray(list1, array3);
+    printf(" list2 added array with array1\n"); linkedlist_addarray(list2, array1);
+    printf(" list1 "); linkedlist_printint(list1); printf("\n");
+    printf(" list2 "); linkedlist_printint(list2); printf("\n");
+    printf(" list1 rotated by %d\n", 3); linkedlist_rotate(list1, 3);
+    printf(" list1 "); linkedlist_printint(list1); printf("\n");
+    printf(" list1[2] spliced with list2\n"); linkedlist_splice(list1, 2, list2);
+    printf(" list1 "); linkedlist_printint(list1); printf("\n");
+    printf(" list2 "); linkedlist_printint(list2); printf("\n");
+    printf(" list1 split at 6 into list2\n"); linkedlist_split(list1, 6, list2);
+    printf(" list1 "); linkedlist_printint(list1); printf("\n");
+    printf(" list2 "); linkedlist_printint(list2); printf("\n");
+    printf(" list2 concatenated with list1\n"); linkedlist_concat(list2, list1);
+    printf(" list1 "); linkedlist_printint(list1); printf("\n");
+    printf(" list2 "); linkedlist_printint(list2); printf("\n");
+    printf(" list2 destroyed\n"); linkedlist_destroy(list2);
+
+    printf(" --------\n");
+
+    linkedlist_t l3, *list3 = &l3, l4, *list4 = &l4, l5, *list5 = &l5;
+    linkedlist_codec_t codec = { testencode, testdecode };
+    FILE *file = tmpfile();
+    printf(" list1 added array with array5\n"); linkedlist_addarray(list1, array5);
+    printf(" list2 added array with array1\n"); linkedlist_addarray(list2, array1);
+    printf(" list1 saved\n"); linkedlist_save(list1, file, NULL);
+    printf(" list2 saved with codec\n"); linkedlist_save(list2, file, &codec);
+    printf(" list1 saved with codec\n"); linkedlist_save(list1, file, &codec);
+    rewind(file);
+    printf(" list3 loaded\n"); linkedlist_load(list3, NULL, file, NULL);
+    printf(" list4 loaded with codec\n"); linkedlist_load(list4, NULL, file, &codec);
+    printf(" list5 loaded with codec\n"); linkedlist_load(list5, NULL, file, &codec);
+    fclose(file);
+    printf(" list3 "); linkedlist_printint(list3); printf("\n");
+    printf(" list4 "); linkedlist_printint(list4); printf("\n");
+    printf(" list5 "); linkedlist_printint(list5); printf("\n");
+    printf(" list1 destroyed\n"); linkedlist_destroy(list1);
+    printf(" list2 destroyed\n"); linkedlist_destroy(list2);
+    printf(" list3 destroyed\n"); linkedlist_destroy(list3);
+    printf(" list4 destroyed\n"); linkedlist_destroy(list4);
+    printf(" list5 destroyed\n"); linkedlist_destroy(list5);
     return 0;
 }